@@ -51,8 +51,56 @@ Level1 = {
         [30] = { type="texture", id = "heliport-texture", file = "./assets/images/heliport.png" },
         [31] = { type="texture", id = "bullet-friendly-texture", file = "./assets/images/bullet-friendly.png" },
         [32] = { type="texture", id = "radar-texture", file = "./assets/images/radar.png" },
-        [33] = { type="sound", id = "blades-sound", file = "./assets/sounds/blades.wav" },
-        [33] = { type="font", id = "charriot-font", file = "./assets/fonts/charriot.ttf", fontSize = 14 }
+        [33] = { type="sound", id = "blades-sound", file = "./assets/sounds/helicopter.wav", priority = 10, maxVoices = 1 },
+        [34] = { type="font", id = "charriot-font", file = "./assets/fonts/charriot.ttf", fontSize = 14 },
+        [35] = {
+            type = "animation",
+            id = "chopper-animation",
+            frameWidth = 32,
+            frameHeight = 32,
+            clips = {
+                [0] = { name = "down", frames = { [0] = { column = 0, row = 0, duration = 0.09 }, [1] = { column = 1, row = 0, duration = 0.09 } } },
+                [1] = { name = "right", frames = { [0] = { column = 0, row = 1, duration = 0.09 }, [1] = { column = 1, row = 1, duration = 0.09 } } },
+                [2] = { name = "left", frames = { [0] = { column = 0, row = 2, duration = 0.09 }, [1] = { column = 1, row = 2, duration = 0.09 } } },
+                [3] = { name = "up", frames = { [0] = { column = 0, row = 3, duration = 0.09 }, [1] = { column = 1, row = 3, duration = 0.09 } } }
+            },
+            transitions = {
+                [0] = { from = "*", to = "up", when = "up" },
+                [1] = { from = "*", to = "down", when = "down" },
+                [2] = { from = "*", to = "right", when = "right" },
+                [3] = { from = "*", to = "left", when = "left" }
+            }
+        },
+        [36] = {
+            type = "particles",
+            id = "rotor-wash",
+            rate = 60,
+            lifetime = 0.5,
+            lifetimeVariance = 0.15,
+            speed = 45,
+            speedVariance = 15,
+            spread = 360,
+            startSize = 4,
+            endSize = 14,
+            startColor = { r = 210, g = 200, b = 160, a = 70 },
+            endColor = { r = 210, g = 200, b = 160, a = 0 }
+        },
+        [37] = {
+            type = "particles",
+            id = "smoke",
+            rate = 12,
+            lifetime = 2.0,
+            lifetimeVariance = 0.5,
+            speed = 12,
+            speedVariance = 4,
+            direction = 270,
+            spread = 40,
+            gravity = { x = 6, y = -4 },
+            startSize = 6,
+            endSize = 24,
+            startColor = { r = 90, g = 90, b = 90, a = 150 },
+            endColor = { r = 60, g = 60, b = 60, a = 0 }
+        }
     },
 
     ----------------------------------------------------
@@ -91,15 +139,23 @@ Level1 = {
                 },
                 sprite = {
                     textureAssetId = "chopper-texture",
-                    animated = true,
-                    frameCount = 2,
-                    animationSpeed = 90,
-                    hasDirections = true,
+                    animated = false,
                     fixed = false
                 },
+                animator = {
+                    animationAssetId = "chopper-animation"
+                },
+                particles = {
+                    particleAssetId = "rotor-wash",
+                    offset = { x = 16, y = 16 }
+                },
                 collider = {
                     tag = "PLAYER"
                 },
+                sound = {
+                    soundAssetId = "blades-sound",
+                    loop = true
+                },
                 input = {
                     keyboard = {
                         up = "w",
@@ -107,6 +163,13 @@ Level1 = {
                         down = "s",
                         right = "d",
                         shoot = "space"
+                    },
+                    gamepad = {
+                        up = "dpup",
+                        left = "dpleft",
+                        down = "dpdown",
+                        right = "dpright",
+                        shoot = "a"
                     }
                 }
             }
@@ -184,6 +247,10 @@ Level1 = {
                     textureAssetId = "tank-big-left-texture",
                     animated = false
                 },
+                particles = {
+                    particleAssetId = "smoke",
+                    offset = { x = 20, y = 8 }
+                },
                 collider = {
                     tag = "ENEMY"
                 },
@@ -1535,6 +1602,9 @@ Level1 = {
                     animationSpeed = 150,
                     hasDirections = false,
                     fixed = true
+                },
+                minimap = {
+                    layers = { 2, 3, 4 }
                 }
             }
         }
@@ -0,0 +1,23 @@
+#include <iostream>
+#include <string>
+#include "./Benchmark.h"
+
+int main(int argc, char *args[]) {
+    std::string jsonFilePath;
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = args[i];
+        if (argument.compare(0, 7, "--json=") == 0) {
+            jsonFilePath = argument.substr(7);
+        }
+        if (argument.compare(0, 9, "--filter=") == 0) {
+            filter = argument.substr(9);
+        }
+    }
+    std::vector<BenchmarkResult> results = Benchmark::RunAll(filter);
+    if (!jsonFilePath.empty()) {
+        Benchmark::WriteJson(results, jsonFilePath);
+        std::cout << "Wrote " << results.size() << " results to " << jsonFilePath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "./Benchmark.h"
+#include "../src/Kinematics.h"
+
+// each case runs until it has spent this long in the timed body, but at least once
+static const double MIN_BENCHMARK_TIME_NS = 0.5e9;
+static const unsigned int MAX_BENCHMARK_ITERATIONS = 1000;
+
+BenchmarkState::BenchmarkState(unsigned int scale): scale(scale) {
+
+}
+
+unsigned int BenchmarkState::GetScale() const {
+    return scale;
+}
+
+void BenchmarkState::Run(const std::function<void()>& body) {
+    Run([]() {}, body);
+}
+
+void BenchmarkState::Run(const std::function<void()>& setup, const std::function<void()>& body) {
+    double totalNs = 0.0;
+    while (samples.size() < MAX_BENCHMARK_ITERATIONS && (samples.empty() || totalNs < MIN_BENCHMARK_TIME_NS)) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        double sampleNs = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.emplace_back(sampleNs);
+        totalNs += sampleNs;
+    }
+}
+
+const std::vector<double>& BenchmarkState::GetSamples() const {
+    return samples;
+}
+
+std::vector<Benchmark::Case>& Benchmark::GetCases() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+int Benchmark::Register(std::string name, std::vector<unsigned int> scales, std::function<void(BenchmarkState&)> function) {
+    GetCases().push_back({name, scales, function});
+    return GetCases().size();
+}
+
+std::vector<BenchmarkResult> Benchmark::RunAll(std::string filter) {
+    std::vector<BenchmarkResult> results;
+    for (auto& benchmarkCase: GetCases()) {
+        if (!filter.empty() && benchmarkCase.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        for (auto scale: benchmarkCase.scales) {
+            BenchmarkState state(scale);
+            benchmarkCase.function(state);
+            const std::vector<double>& samples = state.GetSamples();
+            if (samples.empty()) {
+                continue;
+            }
+            double total = 0.0;
+            for (auto sample: samples) {
+                total += sample;
+            }
+            BenchmarkResult result = {
+                benchmarkCase.name,
+                scale,
+                static_cast<unsigned int>(samples.size()),
+                total / samples.size(),
+                *std::min_element(samples.begin(), samples.end()),
+                *std::max_element(samples.begin(), samples.end())
+            };
+            std::cout << std::left << std::setw(40) << result.name
+                << std::right << std::setw(8) << result.scale
+                << std::setw(8) << result.iterations
+                << std::setw(16) << std::fixed << std::setprecision(3) << result.meanNs / 1e6 << " ms" << std::endl;
+            results.emplace_back(result);
+        }
+    }
+    return results;
+}
+
+void Benchmark::WriteJson(const std::vector<BenchmarkResult>& results, std::string filePath) {
+    std::ofstream file(filePath);
+    std::time_t now = std::time(NULL);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    file << "{\n";
+    file << "  \"context\": {\"date\": \"" << date << "\", \"instruction_set\": \"" << Kinematics::GetInstructionSet() << "\"},\n";
+    file << "  \"benchmarks\": [\n";
+    for (unsigned int i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        file << "    {\"name\": \"" << result.name << "\", \"scale\": " << result.scale
+            << ", \"iterations\": " << result.iterations
+            << std::fixed << std::setprecision(1)
+            << ", \"mean_ns\": " << result.meanNs
+            << ", \"min_ns\": " << result.minNs
+            << ", \"max_ns\": " << result.maxNs << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+}
@@ -0,0 +1,48 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+    std::string name;
+    unsigned int scale;
+    unsigned int iterations;
+    double meanNs;
+    double minNs;
+    double maxNs;
+};
+
+class BenchmarkState {
+    private:
+        unsigned int scale;
+        std::vector<double> samples;
+    public:
+        BenchmarkState(unsigned int scale);
+        unsigned int GetScale() const;
+        void Run(const std::function<void()>& body);
+        void Run(const std::function<void()>& setup, const std::function<void()>& body);
+        const std::vector<double>& GetSamples() const;
+};
+
+class Benchmark {
+    private:
+        struct Case {
+            std::string name;
+            std::vector<unsigned int> scales;
+            std::function<void(BenchmarkState&)> function;
+        };
+        static std::vector<Case>& GetCases();
+    public:
+        static int Register(std::string name, std::vector<unsigned int> scales, std::function<void(BenchmarkState&)> function);
+        static std::vector<BenchmarkResult> RunAll(std::string filter);
+        static void WriteJson(const std::vector<BenchmarkResult>& results, std::string filePath);
+};
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+#define BENCHMARK(name, scales, function) \
+    static int BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = Benchmark::Register(name, scales, function)
+
+#endif
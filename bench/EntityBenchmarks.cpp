@@ -0,0 +1,95 @@
+#include <cmath>
+#include <string>
+#include "./Benchmark.h"
+#include "../src/EntityManager.h"
+#include "../src/JobSystem.h"
+#include "../src/Components/TransformComponent.h"
+#include "../src/Components/SpriteComponent.h"
+#include "../src/Components/ColliderComponent.h"
+#include "../src/Components/ProjectileEmitterComponent.h"
+
+static const std::vector<unsigned int> ENTITY_SCALES = {1000, 10000, 100000};
+// the collision pass is quadratic, larger scales would run for minutes
+static const std::vector<unsigned int> COLLISION_SCALES = {1000, 10000};
+
+// entities are laid out on a grid with gaps so no pair overlaps and every pair gets tested
+static void PopulateEntities(EntityManager& entityManager, unsigned int count, bool isMoving) {
+    unsigned int columns = static_cast<unsigned int>(std::sqrt(static_cast<double>(count))) + 1;
+    for (unsigned int i = 0; i < count; i++) {
+        int x = (i % columns) * 48;
+        int y = (i / columns) * 48;
+        constants::LayerType layer = (i % 2 == 0) ? constants::ENEMY_LAYER : constants::VEGETATION_LAYER;
+        Entity& entity(entityManager.AddEntity("entity" + std::to_string(i), layer));
+        entity.AddComponent<TransformComponent>(x, y, isMoving ? static_cast<int>(i % 3) - 1 : 0, 0, 32, 32, 1);
+        entity.AddComponent<SpriteComponent>("bench-texture");
+        if (isMoving && i % 10 == 0) {
+            entity.AddComponent<ProjectileEmitterComponent>(50, static_cast<int>(i % 360), 100, true);
+        }
+        entity.AddComponent<ColliderComponent>(i % 2 == 0 ? "ENEMY" : "VEGETATION", x, y, 32, 32);
+    }
+}
+
+BENCHMARK("EntityManager::Update", ENTITY_SCALES, [](BenchmarkState& state) {
+    EntityManager entityManager;
+    PopulateEntities(entityManager, state.GetScale(), true);
+    state.Run([&]() {
+        entityManager.Update(1.0f / constants::TICK_RATE);
+    });
+});
+
+// level content is mostly scenery, nine in ten entities here are flagged static as the level loader would
+BENCHMARK("EntityManager::Update/static", ENTITY_SCALES, [](BenchmarkState& state) {
+    EntityManager entityManager;
+    PopulateEntities(entityManager, state.GetScale(), false);
+    std::vector<Entity*> entities = entityManager.GetEntities();
+    for (unsigned int i = 0; i < entities.size(); i++) {
+        entities[i]->SetStatic(i % 10 != 0);
+    }
+    state.Run([&]() {
+        entityManager.Update(1.0f / constants::TICK_RATE);
+    });
+});
+
+BENCHMARK("EntityManager::UpdateComponents/jobs", ENTITY_SCALES, [](BenchmarkState& state) {
+    EntityManager entityManager;
+    PopulateEntities(entityManager, state.GetScale(), true);
+    JobSystem jobSystem;
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    jobSystem.Initialize(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+    state.Run([&]() {
+        entityManager.UpdateComponents(1.0f / constants::TICK_RATE, jobSystem);
+    });
+    jobSystem.Shutdown();
+});
+
+// every sprite here is an animated directional sheet, as the level's enemies are
+BENCHMARK("EntityManager::AdvanceAnimations", ENTITY_SCALES, [](BenchmarkState& state) {
+    EntityManager entityManager;
+    for (unsigned int i = 0; i < state.GetScale(); i++) {
+        Entity& entity(entityManager.AddEntity("entity" + std::to_string(i), constants::ENEMY_LAYER));
+        entity.AddComponent<TransformComponent>(0, 0, 0, 0, 32, 32, 1);
+        entity.AddComponent<SpriteComponent>("bench-texture", 2, 90, true, false);
+    }
+    state.Run([&]() {
+        entityManager.AdvanceAnimations(1.0f / constants::TICK_RATE);
+    });
+});
+
+BENCHMARK("EntityManager::CheckCollisions", COLLISION_SCALES, [](BenchmarkState& state) {
+    EntityManager entityManager;
+    PopulateEntities(entityManager, state.GetScale(), false);
+    entityManager.Update(1.0f / constants::TICK_RATE);
+    state.Run([&]() {
+        entityManager.CheckCollisions();
+    });
+});
+
+BENCHMARK("EntityManager::GetEntitiesByLayer", ENTITY_SCALES, [](BenchmarkState& state) {
+    EntityManager entityManager;
+    PopulateEntities(entityManager, state.GetScale(), false);
+    state.Run([&]() {
+        for (unsigned int layer = 0; layer < constants::NUM_LAYERS; layer++) {
+            entityManager.GetEntitiesByLayer(static_cast<constants::LayerType>(layer));
+        }
+    });
+});
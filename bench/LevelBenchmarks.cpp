@@ -0,0 +1,75 @@
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "./Benchmark.h"
+#include "../src/Game.h"
+#include "../src/Map.h"
+#include "../src/EntityManager.h"
+
+extern EntityManager manager;
+
+static const std::vector<unsigned int> LEVEL_SCALES = {1000, 10000, 100000};
+static const char* BENCH_MAP_FILE = "./bench_map.map";
+static const char* BENCH_LEVEL_FILE = "./bench_level.lua";
+
+static void ClearLevelEntities() {
+    manager.ClearData();
+    manager.DestroyInactiveEntities();
+}
+
+static unsigned int GetMapSide(unsigned int tileCount) {
+    return static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(tileCount))));
+}
+
+static void WriteMapFile(unsigned int mapSizeX, unsigned int mapSizeY) {
+    std::ofstream mapFile(BENCH_MAP_FILE);
+    for (unsigned int y = 0; y < mapSizeY; y++) {
+        for (unsigned int x = 0; x < mapSizeX; x++) {
+            mapFile << (x + y) % 3 << (x * y) % 10 << (x + 1 < mapSizeX ? "," : "\n");
+        }
+    }
+}
+
+static void WriteLevelFile(unsigned int entityCount) {
+    std::ofstream levelFile(BENCH_LEVEL_FILE);
+    levelFile << "BenchLevel = {\n";
+    levelFile << "    assets = {\n";
+    levelFile << "        [0] = { type=\"texture\", id = \"bench-texture\", file = \"./assets/images/tank-big-down.png\" }\n";
+    levelFile << "    },\n";
+    levelFile << "    map = { textureAssetId = \"bench-texture\", file = \"" << BENCH_MAP_FILE << "\", scale = 2, tileSize = 32, mapSizeX = 16, mapSizeY = 16 },\n";
+    levelFile << "    entities = {\n";
+    for (unsigned int i = 0; i < entityCount; i++) {
+        levelFile << "        [" << i << "] = { name = \"entity" << i << "\", layer = 2, components = {"
+            << " transform = { position = { x = " << (i % 100) * 48 << ", y = " << (i / 100) * 48 << " },"
+            << " velocity = { x = 0, y = 0 }, width = 32, height = 32, scale = 1, rotation = 0 },"
+            << " sprite = { textureAssetId = \"bench-texture\", animated = false },"
+            << " collider = { tag = \"ENEMY\" } } }"
+            << (i + 1 < entityCount ? "," : "") << "\n";
+    }
+    levelFile << "    }\n";
+    levelFile << "}\n";
+}
+
+BENCHMARK("Map::LoadMap", LEVEL_SCALES, [](BenchmarkState& state) {
+    unsigned int side = GetMapSide(state.GetScale());
+    WriteMapFile(side, side);
+    Map map("bench-texture", 2, 32);
+    state.Run(ClearLevelEntities, [&]() {
+        map.LoadMap(BENCH_MAP_FILE, side, side);
+    });
+    ClearLevelEntities();
+    std::remove(BENCH_MAP_FILE);
+});
+
+BENCHMARK("Game::LoadLevel", LEVEL_SCALES, [](BenchmarkState& state) {
+    WriteMapFile(16, 16);
+    WriteLevelFile(state.GetScale());
+    Game game;
+    state.Run(ClearLevelEntities, [&]() {
+        game.LoadLevelScript(BENCH_LEVEL_FILE, "BenchLevel");
+    });
+    ClearLevelEntities();
+    std::remove(BENCH_LEVEL_FILE);
+    std::remove(BENCH_MAP_FILE);
+});
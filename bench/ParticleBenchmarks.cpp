@@ -0,0 +1,32 @@
+#include "./Benchmark.h"
+#include "../src/ParticleSystem.h"
+
+static const std::vector<unsigned int> PARTICLE_SCALES = {1000, 10000, 100000};
+
+static ParticleEmitterDefinition GetBenchDefinition() {
+    ParticleEmitterDefinition definition;
+    definition.rate = 0.0f;
+    definition.burst = 0;
+    // particles live far longer than the run so every iteration updates the full population
+    definition.lifetime = 1000.0f;
+    definition.lifetimeVariance = 0.0f;
+    definition.speed = 40.0f;
+    definition.speedVariance = 20.0f;
+    definition.direction = 0.0f;
+    definition.spread = 360.0f;
+    definition.gravity = glm::vec2(0.0f, 10.0f);
+    definition.startSize = 4.0f;
+    definition.endSize = 8.0f;
+    definition.startColor = constants::WHITE_COLOR;
+    definition.endColor = constants::WHITE_COLOR;
+    return definition;
+}
+
+BENCHMARK("ParticleSystem::Update", PARTICLE_SCALES, [](BenchmarkState& state) {
+    ParticleSystem particleSystem;
+    unsigned int emitter = particleSystem.AddDefinition(GetBenchDefinition());
+    particleSystem.Emit(emitter, glm::vec2(0.0f, 0.0f), state.GetScale());
+    state.Run([&]() {
+        particleSystem.Update(1.0f / constants::TICK_RATE);
+    });
+});
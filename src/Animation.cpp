@@ -1,11 +1,26 @@
 #include "./Animation.h"
 
-Animation::Animation() {
+Animation::Animation(): firstFrame(0), numFrames(1), frameDuration(0.0f) {
 
 }
 
-Animation::Animation(unsigned int index, unsigned int numFrames, unsigned int animationSpeed) {
-    this->index = index;
+Animation::Animation(unsigned int firstFrame, unsigned int numFrames, float frameDuration) {
+    this->firstFrame = firstFrame;
     this->numFrames = numFrames;
-    this->animationSpeed = animationSpeed;
-}
\ No newline at end of file
+    this->frameDuration = frameDuration;
+}
+
+// time is accumulated per animator and frames are stepped by subtraction, so there is no divide per sprite
+// and a replay advances exactly as the recording did
+void Animation::Advance(float* elapsed, unsigned int* frame, const float* frameDuration, const unsigned int* numFrames, unsigned int count, float deltaTime) {
+    for (unsigned int i = 0; i < count; i++) {
+        if (frameDuration[i] <= 0.0f || numFrames[i] < 2) {
+            continue;
+        }
+        elapsed[i] += deltaTime;
+        while (elapsed[i] >= frameDuration[i]) {
+            elapsed[i] -= frameDuration[i];
+            frame[i] = frame[i] + 1 < numFrames[i] ? frame[i] + 1 : 0;
+        }
+    }
+}
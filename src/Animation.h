@@ -1,13 +1,22 @@
 #ifndef ANIMATION_H
 #define ANIMATION_H
 
+// a clip is a run of precomputed source rectangles in its sprite's frame table
 class Animation {
     public:
-        unsigned int index;
+        unsigned int firstFrame;
         unsigned int numFrames;
-        unsigned int animationSpeed;
+        float frameDuration;
         Animation();
-        Animation(unsigned int index, unsigned int numFrames, unsigned int animationSpeed);
+        Animation(unsigned int firstFrame, unsigned int numFrames, float frameDuration);
+        static void Advance(
+            float* elapsed,
+            unsigned int* frame,
+            const float* frameDuration,
+            const unsigned int* numFrames,
+            unsigned int count,
+            float deltaTime
+        );
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,176 @@
+#include <iostream>
+#include "./AnimationGraph.h"
+#include "./Constants.h"
+
+unsigned int AnimationGraph::AddClip(const std::string& name, bool isLooping) {
+    clips.push_back({name, static_cast<unsigned int>(frames.size()), 0, isLooping, 0, 0});
+    return clips.size() - 1;
+}
+
+// frames belong to the clip added last
+void AnimationGraph::AddFrame(const SDL_Rect& source, float duration, unsigned int event) {
+    if (clips.empty()) {
+        std::cerr << "Animation frame added before any clip" << std::endl;
+        return;
+    }
+    frames.push_back({source, duration, event});
+    clips.back().numFrames++;
+}
+
+// "*" as the source state applies the transition from every clip, after that clip's own transitions
+void AnimationGraph::AddTransition(const std::string& from, const std::string& to, const std::string& when) {
+    transitionSources.push_back({from, to, when});
+}
+
+int AnimationGraph::FindClip(const std::string& name) const {
+    for (unsigned int i = 0; i < clips.size(); i++) {
+        if (clips[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool AnimationGraph::ParseCondition(const std::string& when, unsigned int& condition) {
+    static const char* const CONDITION_NAMES[CONDITION_ACTION] = {
+        "always", "idle", "moving", "up", "down", "left", "right", "finished"
+    };
+    for (unsigned int i = 0; i < CONDITION_ACTION; i++) {
+        if (when == CONDITION_NAMES[i]) {
+            condition = i;
+            return true;
+        }
+    }
+    for (unsigned int action = 0; action < constants::NUM_ACTIONS; action++) {
+        if (when == std::string("action:") + constants::ACTION_NAMES[action]) {
+            condition = CONDITION_ACTION + action;
+            return true;
+        }
+    }
+    return false;
+}
+
+// names are resolved once here so evaluation only ever indexes the flat tables
+bool AnimationGraph::Compile() {
+    bool isValid = !clips.empty();
+    transitions.clear();
+    for (unsigned int clip = 0; clip < clips.size(); clip++) {
+        if (clips[clip].numFrames == 0) {
+            std::cerr << "Animation clip " << clips[clip].name << " has no frames" << std::endl;
+            isValid = false;
+        }
+        clips[clip].firstTransition = transitions.size();
+        for (int pass = 0; pass < 2; pass++) {
+            for (auto &source: transitionSources) {
+                bool isAnyState = source.from == "*";
+                if ((pass == 0 && (isAnyState || FindClip(source.from) != static_cast<int>(clip))) || (pass == 1 && !isAnyState)) {
+                    continue;
+                }
+                int target = FindClip(source.to);
+                unsigned int condition = CONDITION_ALWAYS;
+                if (target < 0 || !ParseCondition(source.when, condition)) {
+                    std::cerr << "Invalid animation transition " << source.from << " -> " << source.to << " when " << source.when << std::endl;
+                    isValid = false;
+                    continue;
+                }
+                if (target != static_cast<int>(clip)) {
+                    transitions.push_back({static_cast<unsigned int>(target), condition});
+                }
+            }
+        }
+        clips[clip].numTransitions = transitions.size() - clips[clip].firstTransition;
+    }
+    for (auto &source: transitionSources) {
+        if (source.from != "*" && FindClip(source.from) < 0) {
+            std::cerr << "Animation transition from unknown clip " << source.from << std::endl;
+            isValid = false;
+        }
+    }
+    transitionSources.clear();
+    return isValid;
+}
+
+unsigned int AnimationGraph::GetClipCount() const {
+    return clips.size();
+}
+
+const SDL_Rect& AnimationGraph::GetSource(unsigned int clip, unsigned int frame) const {
+    return frames[clips[clip].firstFrame + frame].source;
+}
+
+unsigned int AnimationGraph::GetEvent(unsigned int clip, unsigned int frame) const {
+    return frames[clips[clip].firstFrame + frame].event;
+}
+
+static bool IsConditionMet(unsigned int condition, float velocityX, float velocityY, bool isFinished, unsigned int actions) {
+    switch (condition) {
+        case CONDITION_ALWAYS: return true;
+        case CONDITION_IDLE: return velocityX == 0.0f && velocityY == 0.0f;
+        case CONDITION_MOVING: return velocityX != 0.0f || velocityY != 0.0f;
+        case CONDITION_MOVING_UP: return velocityY < 0.0f;
+        case CONDITION_MOVING_DOWN: return velocityY > 0.0f;
+        case CONDITION_MOVING_LEFT: return velocityX < 0.0f;
+        case CONDITION_MOVING_RIGHT: return velocityX > 0.0f;
+        case CONDITION_FINISHED: return isFinished;
+        default: return (actions & (1u << (condition - CONDITION_ACTION))) != 0;
+    }
+}
+
+// one pass over every animator: take the first transition whose condition holds, then step through
+// the clip's frames by their own durations and collect the events of each frame entered
+void AnimationGraph::Evaluate(
+    const AnimationGraph* const* graphs,
+    unsigned int* clip,
+    unsigned int* frame,
+    float* elapsed,
+    unsigned char* isFinished,
+    unsigned char* isChanged,
+    const float* velocityX,
+    const float* velocityY,
+    const unsigned int* actions,
+    unsigned int count,
+    float deltaTime,
+    std::vector<AnimationEvent>& events
+) {
+    for (unsigned int i = 0; i < count; i++) {
+        const AnimationGraph& graph = *graphs[i];
+        isChanged[i] = 0;
+        const AnimationClip* current = &graph.clips[clip[i]];
+        const AnimationTransition* transition = graph.transitions.data() + current->firstTransition;
+        for (unsigned int t = 0; t < current->numTransitions; t++, transition++) {
+            if (IsConditionMet(transition->condition, velocityX[i], velocityY[i], isFinished[i] != 0, actions[i])) {
+                clip[i] = transition->target;
+                frame[i] = 0;
+                elapsed[i] = 0.0f;
+                isFinished[i] = 0;
+                isChanged[i] = 1;
+                current = &graph.clips[clip[i]];
+                if (graph.frames[current->firstFrame].event != constants::NO_SOUND) {
+                    events.push_back({i, graph.frames[current->firstFrame].event});
+                }
+                break;
+            }
+        }
+        if (isFinished[i]) {
+            continue;
+        }
+        elapsed[i] += deltaTime;
+        const AnimationFrame* frames = graph.frames.data() + current->firstFrame;
+        while (frames[frame[i]].duration > 0.0f && elapsed[i] >= frames[frame[i]].duration) {
+            elapsed[i] -= frames[frame[i]].duration;
+            if (frame[i] + 1 < current->numFrames) {
+                frame[i]++;
+            } else if (current->isLooping) {
+                frame[i] = 0;
+            } else {
+                isFinished[i] = 1;
+                elapsed[i] = 0.0f;
+                break;
+            }
+            isChanged[i] = 1;
+            if (frames[frame[i]].event != constants::NO_SOUND) {
+                events.push_back({i, frames[frame[i]].event});
+            }
+        }
+    }
+}
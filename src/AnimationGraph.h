@@ -0,0 +1,86 @@
+#ifndef ANIMATIONGRAPH_H
+#define ANIMATIONGRAPH_H
+
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+enum AnimationCondition {
+    CONDITION_ALWAYS,
+    CONDITION_IDLE,
+    CONDITION_MOVING,
+    CONDITION_MOVING_UP,
+    CONDITION_MOVING_DOWN,
+    CONDITION_MOVING_LEFT,
+    CONDITION_MOVING_RIGHT,
+    CONDITION_FINISHED,
+    CONDITION_ACTION
+};
+
+struct AnimationFrame {
+    SDL_Rect source;
+    float duration;
+    unsigned int event;
+};
+
+struct AnimationClip {
+    std::string name;
+    unsigned int firstFrame;
+    unsigned int numFrames;
+    bool isLooping;
+    unsigned int firstTransition;
+    unsigned int numTransitions;
+};
+
+// a condition at or above CONDITION_ACTION holds while that input action is down
+struct AnimationTransition {
+    unsigned int target;
+    unsigned int condition;
+};
+
+struct AnimationEvent {
+    unsigned int animator;
+    unsigned int event;
+};
+
+struct AnimationTransitionSource {
+    std::string from;
+    std::string to;
+    std::string when;
+};
+
+// clips and state transitions authored in a level script, compiled into flat frame and transition tables
+// that every animator using the graph reads from
+class AnimationGraph {
+    private:
+        std::vector<AnimationFrame> frames;
+        std::vector<AnimationClip> clips;
+        std::vector<AnimationTransition> transitions;
+        std::vector<AnimationTransitionSource> transitionSources;
+        int FindClip(const std::string& name) const;
+        static bool ParseCondition(const std::string& when, unsigned int& condition);
+    public:
+        unsigned int AddClip(const std::string& name, bool isLooping);
+        void AddFrame(const SDL_Rect& source, float duration, unsigned int event);
+        void AddTransition(const std::string& from, const std::string& to, const std::string& when);
+        bool Compile();
+        unsigned int GetClipCount() const;
+        const SDL_Rect& GetSource(unsigned int clip, unsigned int frame) const;
+        unsigned int GetEvent(unsigned int clip, unsigned int frame) const;
+        static void Evaluate(
+            const AnimationGraph* const* graphs,
+            unsigned int* clip,
+            unsigned int* frame,
+            float* elapsed,
+            unsigned char* isFinished,
+            unsigned char* isChanged,
+            const float* velocityX,
+            const float* velocityY,
+            const unsigned int* actions,
+            unsigned int count,
+            float deltaTime,
+            std::vector<AnimationEvent>& events
+        );
+};
+
+#endif
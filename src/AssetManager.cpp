@@ -1,20 +1,81 @@
+#include <fstream>
+#include <iostream>
 #include "./AssetManager.h"
+#include "./Metrics.h"
 
 AssetManager::AssetManager(EntityManager* manager): manager(manager) {
 
 }
 
 void AssetManager::ClearData() {
+    for (auto& texture: textures) {
+        if (texture.second) {
+            SDL_DestroyTexture(texture.second);
+        }
+    }
     textures.clear();
+    UpdateTextureMetrics();
     fonts.clear();
+    fontVariants.clear();
+    for (auto& glyphAtlas: glyphAtlases) {
+        delete glyphAtlas.second;
+    }
+    glyphAtlases.clear();
+    sounds.clear();
+    for (auto& animationGraph: animationGraphs) {
+        delete animationGraph.second;
+    }
+    animationGraphs.clear();
+    particleEmitters.clear();
 }
 
 void AssetManager::AddTexture(std::string textureId, const char* filePath) {
     textures.emplace(textureId, TextureManager::LoadTexture(filePath));
+    UpdateTextureMetrics();
 }
 
-void AssetManager::AddFont(std::string fontId, const char* filePath, int fontSize) {
-    fonts.emplace(fontId, FontManager::LoadFont(filePath, fontSize));
+// the gauge is recomputed from the live texture set, so it drops again when textures are released
+void AssetManager::UpdateTextureMetrics() const {
+    static const unsigned int textureBytes = Metrics::Register("texture bytes", METRIC_GAUGE);
+    double bytes = 0.0;
+    for (auto& texture: textures) {
+        int width = 0;
+        int height = 0;
+        if (texture.second && SDL_QueryTexture(texture.second, NULL, NULL, &width, &height) == 0) {
+            bytes += static_cast<double>(width) * height * 4;
+        }
+    }
+    Metrics::Set(textureBytes, bytes);
+}
+
+const std::vector<char>& AssetManager::LoadFontFile(const std::string& filePath) {
+    // every size of a font reads from the same in-memory copy of its file
+    auto fontFile = fontFiles.find(filePath);
+    if (fontFile == fontFiles.end()) {
+        fontFile = fontFiles.emplace(filePath, std::vector<char>()).first;
+        std::ifstream file(filePath.c_str(), std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error opening font file " << filePath << std::endl;
+        } else {
+            fontFile->second.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    }
+    return fontFile->second;
+}
+
+void AssetManager::AddFont(std::string fontId, const char* filePath, int fontSize, bool isScalable) {
+    if (!isScalable) {
+        fonts.emplace(fontId, FontManager::LoadFont(LoadFontFile(filePath), fontSize));
+        fontVariants.emplace(fontId, FontVariant{fontId, 1.0f, false});
+        return;
+    }
+    // scalable sizes share one font and atlas opened at the reference size and only differ in their scale
+    std::string atlasId = std::string(filePath) + "@scalable";
+    if (fonts.count(atlasId) == 0) {
+        fonts.emplace(atlasId, FontManager::LoadFont(LoadFontFile(filePath), constants::SCALABLE_FONT_SIZE));
+    }
+    fonts.emplace(fontId, fonts[atlasId]);
+    fontVariants.emplace(fontId, FontVariant{atlasId, static_cast<float>(fontSize) / constants::SCALABLE_FONT_SIZE, true});
 }
 
 SDL_Texture* AssetManager::GetTexture(std::string textureId) {
@@ -25,3 +86,56 @@ TTF_Font* AssetManager::GetFont(std::string fontId) {
     return fonts[fontId];
 }
 
+GlyphAtlas* AssetManager::GetGlyphAtlas(std::string fontId) {
+    // the atlas is built the first time a label asks for the font
+    FontVariant variant = {fontId, 1.0f, false};
+    auto fontVariant = fontVariants.find(fontId);
+    if (fontVariant != fontVariants.end()) {
+        variant = fontVariant->second;
+    }
+    auto glyphAtlas = glyphAtlases.find(variant.atlasId);
+    if (glyphAtlas == glyphAtlases.end()) {
+        glyphAtlas = glyphAtlases.emplace(variant.atlasId, new GlyphAtlas(GetFont(variant.atlasId), variant.isScalable)).first;
+    }
+    return glyphAtlas->second;
+}
+
+float AssetManager::GetFontScale(std::string fontId) {
+    auto fontVariant = fontVariants.find(fontId);
+    return fontVariant == fontVariants.end() ? 1.0f : fontVariant->second.scale;
+}
+
+void AssetManager::AddSound(std::string soundId, const char* filePath, int priority, unsigned int maxVoices) {
+    Mix_Chunk* chunk = Game::audioManager->LoadChunk(filePath);
+    sounds.emplace(soundId, Game::audioManager->AddSound(chunk, priority, maxVoices));
+}
+
+// sounds are resolved to an id once when a component is built, playing by id never touches the map
+unsigned int AssetManager::GetSound(std::string soundId) {
+    auto sound = sounds.find(soundId);
+    return sound == sounds.end() ? constants::NO_SOUND : sound->second;
+}
+
+void AssetManager::AddAnimationGraph(std::string animationId, AnimationGraph* graph) {
+    auto existing = animationGraphs.find(animationId);
+    if (existing != animationGraphs.end()) {
+        delete existing->second;
+        existing->second = graph;
+    } else {
+        animationGraphs.emplace(animationId, graph);
+    }
+}
+
+AnimationGraph* AssetManager::GetAnimationGraph(std::string animationId) {
+    auto animationGraph = animationGraphs.find(animationId);
+    return animationGraph == animationGraphs.end() ? NULL : animationGraph->second;
+}
+
+void AssetManager::AddParticleEmitter(std::string emitterId, const ParticleEmitterDefinition& definition) {
+    particleEmitters[emitterId] = Game::particleSystem->AddDefinition(definition);
+}
+
+unsigned int AssetManager::GetParticleEmitter(std::string emitterId) {
+    auto particleEmitter = particleEmitters.find(emitterId);
+    return particleEmitter == particleEmitters.end() ? constants::NO_PARTICLE_EMITTER : particleEmitter->second;
+}
@@ -3,24 +3,51 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <SDL2/SDL_ttf.h>
 #include "./TextureManager.h"
 #include "./FontManager.h"
+#include "./GlyphAtlas.h"
+#include "./AudioManager.h"
+#include "./AnimationGraph.h"
+#include "./ParticleSystem.h"
 #include "./EntityManager.h"
 
+struct FontVariant {
+    std::string atlasId;
+    float scale;
+    bool isScalable;
+};
+
 class AssetManager {
     private:
         EntityManager* manager;
         std::map<std::string, SDL_Texture*> textures;
         std::map<std::string, TTF_Font*> fonts;
+        std::map<std::string, std::vector<char>> fontFiles;
+        std::map<std::string, FontVariant> fontVariants;
+        std::map<std::string, GlyphAtlas*> glyphAtlases;
+        std::map<std::string, unsigned int> sounds;
+        std::map<std::string, AnimationGraph*> animationGraphs;
+        std::map<std::string, unsigned int> particleEmitters;
+        const std::vector<char>& LoadFontFile(const std::string& filePath);
+        void UpdateTextureMetrics() const;
     public:
         AssetManager(EntityManager* manager);
         ~AssetManager();
         void ClearData();
         void AddTexture(std::string textureId, const char* filePath); 
-        void AddFont(std::string fontId, const char* filePath, int fontSize);
+        void AddFont(std::string fontId, const char* filePath, int fontSize, bool isScalable = false);
         SDL_Texture* GetTexture(std::string textureId);
         TTF_Font* GetFont(std::string fontId);
+        GlyphAtlas* GetGlyphAtlas(std::string fontId);
+        float GetFontScale(std::string fontId);
+        void AddSound(std::string soundId, const char* filePath, int priority, unsigned int maxVoices);
+        unsigned int GetSound(std::string soundId);
+        void AddAnimationGraph(std::string animationId, AnimationGraph* graph);
+        AnimationGraph* GetAnimationGraph(std::string animationId);
+        void AddParticleEmitter(std::string emitterId, const ParticleEmitterDefinition& definition);
+        unsigned int GetParticleEmitter(std::string emitterId);
 };
 
 #endif
\ No newline at end of file
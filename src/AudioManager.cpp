@@ -0,0 +1,183 @@
+#include <cmath>
+#include <iostream>
+#include "./AudioManager.h"
+#include "./Game.h"
+
+AudioManager::AudioManager() {
+    isOpen = false;
+    playSequence = 0;
+    for (auto& voice: voices) {
+        voice = {constants::NO_SOUND, 0, 0};
+    }
+}
+
+AudioManager::~AudioManager() {
+}
+
+bool AudioManager::Initialize() {
+    if (Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, constants::AUDIO_CHUNK_SIZE) != 0) {
+        std::cerr << "Error opening audio device: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    Mix_AllocateChannels(constants::AUDIO_VOICE_COUNT);
+    musicStream.Start();
+    isOpen = true;
+    return true;
+}
+
+void AudioManager::Destroy() {
+    if (!isOpen) {
+        return;
+    }
+    musicStream.Shutdown();
+    Mix_HaltChannel(-1);
+    for (auto& sound: sounds) {
+        Mix_FreeChunk(sound.chunk);
+    }
+    sounds.clear();
+    Mix_CloseAudio();
+    isOpen = false;
+}
+
+bool AudioManager::IsOpen() const {
+    return isOpen;
+}
+
+Mix_Chunk* AudioManager::LoadChunk(const char* fileName) {
+    // headless runs never open the device, so sounds are skipped like textures
+    if (!isOpen) {
+        return NULL;
+    }
+    Mix_Chunk* chunk = Mix_LoadWAV(fileName);
+    if (!chunk) {
+        std::cerr << "Error loading sound " << fileName << ": " << SDL_GetError() << std::endl;
+    }
+    return chunk;
+}
+
+unsigned int AudioManager::AddSound(Mix_Chunk* chunk, int priority, unsigned int maxVoices) {
+    if (!chunk) {
+        return constants::NO_SOUND;
+    }
+    sounds.push_back({chunk, priority, maxVoices > 0 ? maxVoices : 1});
+    return static_cast<unsigned int>(sounds.size() - 1);
+}
+
+int AudioManager::FindVoice(unsigned int soundId) {
+    const Sound& sound = sounds[soundId];
+    int idleVoice = -1;
+    int oldestSameSound = -1;
+    int weakestVoice = -1;
+    unsigned int sameSoundCount = 0;
+    for (int channel = 0; channel < static_cast<int>(constants::AUDIO_VOICE_COUNT); channel++) {
+        Voice& voice = voices[channel];
+        if (voice.soundId == constants::NO_SOUND || !Mix_Playing(channel)) {
+            voice.soundId = constants::NO_SOUND;
+            if (idleVoice < 0) {
+                idleVoice = channel;
+            }
+            continue;
+        }
+        if (voice.soundId == soundId) {
+            sameSoundCount++;
+            if (oldestSameSound < 0 || voice.sequence < voices[oldestSameSound].sequence) {
+                oldestSameSound = channel;
+            }
+        }
+        if (weakestVoice < 0 || voice.priority < voices[weakestVoice].priority ||
+            (voice.priority == voices[weakestVoice].priority && voice.sequence < voices[weakestVoice].sequence)) {
+            weakestVoice = channel;
+        }
+    }
+    // a sound over its own limit restarts its oldest voice instead of taking another one
+    if (sameSoundCount >= sound.maxVoices) {
+        return oldestSameSound;
+    }
+    if (idleVoice >= 0) {
+        return idleVoice;
+    }
+    // with every voice busy the lowest priority, oldest voice is stolen unless it outranks the new sound
+    if (weakestVoice >= 0 && voices[weakestVoice].priority <= sound.priority) {
+        return weakestVoice;
+    }
+    return -1;
+}
+
+int AudioManager::Play(unsigned int soundId, int loops) {
+    if (!isOpen || soundId >= sounds.size()) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    int channel = FindVoice(soundId);
+    if (channel < 0) {
+        return -1;
+    }
+    voices[channel] = {soundId, sounds[soundId].priority, playSequence++};
+    if (Mix_PlayChannel(channel, sounds[soundId].chunk, loops) < 0) {
+        voices[channel].soundId = constants::NO_SOUND;
+        return -1;
+    }
+    return channel;
+}
+
+int AudioManager::PlayAt(unsigned int soundId, const glm::vec2& position, int loops) {
+    if (!isOpen || soundId >= sounds.size()) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    int channel = FindVoice(soundId);
+    if (channel < 0) {
+        return -1;
+    }
+    voices[channel] = {soundId, sounds[soundId].priority, playSequence++};
+    // the mixer drops a channel's effects when it restarts, so the position is applied after the chunk starts
+    if (Mix_PlayChannel(channel, sounds[soundId].chunk, loops) < 0) {
+        voices[channel].soundId = constants::NO_SOUND;
+        return -1;
+    }
+    SetChannelPosition(channel, position);
+    return channel;
+}
+
+void AudioManager::SetVoicePosition(int voice, unsigned int soundId, const glm::vec2& position) {
+    if (!isOpen || voice < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    // the voice may have been stolen by another sound since it was started
+    if (voices[voice].soundId == soundId) {
+        SetChannelPosition(voice, position);
+    }
+}
+
+void AudioManager::Stop(int voice, unsigned int soundId) {
+    if (!isOpen || voice < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    if (voices[voice].soundId == soundId) {
+        Mix_HaltChannel(voice);
+        voices[voice].soundId = constants::NO_SOUND;
+    }
+}
+
+// both calls only queue the request, the decoder thread opens the track and crossfades it in
+void AudioManager::PlayMusic(const std::string& filePath, int fadeMs, bool isLooping) {
+    musicStream.Play(filePath, fadeMs, isLooping);
+}
+
+void AudioManager::StopMusic(int fadeMs) {
+    musicStream.Stop(fadeMs);
+}
+
+void AudioManager::SetChannelPosition(int channel, const glm::vec2& position) {
+    // the listener sits in the middle of the camera, panning follows the horizontal offset and volume the distance
+    const Camera& camera = Game::cameras.front();
+    glm::vec2 listener = camera.GetCenter();
+    glm::vec2 offset = position - listener;
+    float pan = glm::clamp(offset.x / (camera.GetViewSize().x / 2.0f), -1.0f, 1.0f);
+    Uint8 right = static_cast<Uint8>(127.0f + pan * 127.0f);
+    float distance = glm::clamp(glm::length(offset) / constants::AUDIO_MAX_DISTANCE, 0.0f, 1.0f);
+    Mix_SetPanning(channel, 254 - right, right);
+    Mix_SetDistance(channel, static_cast<Uint8>(distance * 255.0f));
+}
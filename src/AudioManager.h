@@ -0,0 +1,51 @@
+#ifndef AUDIOMANAGER_H
+#define AUDIOMANAGER_H
+
+#include <mutex>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include "./Constants.h"
+#include "./MusicStream.h"
+#include "../lib/glm/glm.hpp"
+
+struct Sound {
+    Mix_Chunk* chunk;
+    int priority;
+    unsigned int maxVoices;
+};
+
+struct Voice {
+    unsigned int soundId;
+    int priority;
+    unsigned int sequence;
+};
+
+// sounds are registered once at load time and played by id, every voice is one mixer channel from a fixed pool
+class AudioManager {
+    private:
+        bool isOpen;
+        std::vector<Sound> sounds;
+        Voice voices[constants::AUDIO_VOICE_COUNT];
+        unsigned int playSequence;
+        std::mutex voiceMutex;
+        MusicStream musicStream;
+        int FindVoice(unsigned int soundId);
+        void SetChannelPosition(int channel, const glm::vec2& position);
+    public:
+        AudioManager();
+        ~AudioManager();
+        bool Initialize();
+        void Destroy();
+        bool IsOpen() const;
+        Mix_Chunk* LoadChunk(const char* fileName);
+        unsigned int AddSound(Mix_Chunk* chunk, int priority, unsigned int maxVoices);
+        int Play(unsigned int soundId, int loops = 0);
+        int PlayAt(unsigned int soundId, const glm::vec2& position, int loops = 0);
+        void SetVoicePosition(int voice, unsigned int soundId, const glm::vec2& position);
+        void Stop(int voice, unsigned int soundId);
+        void PlayMusic(const std::string& filePath, int fadeMs, bool isLooping);
+        void StopMusic(int fadeMs);
+};
+
+#endif
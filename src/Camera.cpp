@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cmath>
+#include "./Camera.h"
+#include "./Constants.h"
+
+Camera::Camera(): Camera({0, 0, constants::WINDOW_WIDTH, constants::WINDOW_HEIGHT}, 1.0f) {
+}
+
+Camera::Camera(SDL_Rect viewport, float zoom): position(0.0f, 0.0f), zoom(zoom), viewport(viewport), layerMask(constants::ALL_LAYERS), target(NULL) {
+}
+
+glm::vec2 Camera::GetViewSize() const {
+    return glm::vec2(viewport.w / zoom, viewport.h / zoom);
+}
+
+glm::vec2 Camera::GetCenter() const {
+    return position + GetViewSize() * 0.5f;
+}
+
+SDL_FRect Camera::WorldToScreen(const SDL_FRect& world) const {
+    return {
+        viewport.x + (world.x - position.x) * zoom,
+        viewport.y + (world.y - position.y) * zoom,
+        world.w * zoom,
+        world.h * zoom
+    };
+}
+
+bool Camera::IsVisible(const SDL_FRect& world) const {
+    glm::vec2 viewSize = GetViewSize();
+    return world.x + world.w > position.x && world.x < position.x + viewSize.x &&
+        world.y + world.h > position.y && world.y < position.y + viewSize.y;
+}
+
+bool Camera::HasLayer(unsigned int layer) const {
+    return (layerMask & (1u << layer)) != 0;
+}
+
+void Camera::CenterOn(const glm::vec2& target) {
+    position = target - GetViewSize() * 0.5f;
+}
+
+void Camera::Follow(const glm::vec2& target, float deltaTime) {
+    // exponential smoothing keeps the same feel at any frame rate, positions stay fractional so
+    // the view glides instead of stepping a whole pixel at a time
+    glm::vec2 goal = target - GetViewSize() * 0.5f;
+    float blend = 1.0f - std::exp(-deltaTime / constants::CAMERA_SMOOTHING_TIME);
+    position += (goal - position) * blend;
+}
+
+void Camera::ClampTo(const SDL_Rect& worldBounds) {
+    glm::vec2 viewSize = GetViewSize();
+    position.x = glm::clamp(position.x, static_cast<float>(worldBounds.x), std::max(static_cast<float>(worldBounds.x), worldBounds.x + worldBounds.w - viewSize.x));
+    position.y = glm::clamp(position.y, static_cast<float>(worldBounds.y), std::max(static_cast<float>(worldBounds.y), worldBounds.y + worldBounds.h - viewSize.y));
+}
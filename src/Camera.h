@@ -0,0 +1,32 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../lib/glm/glm.hpp"
+
+class Entity;
+
+// a view onto the world, components keep world-space rectangles and the camera maps them
+// to the screen when they are submitted for drawing
+class Camera {
+    public:
+        glm::vec2 position;
+        float zoom;
+        SDL_Rect viewport;
+        unsigned int layerMask;
+        Entity* target;
+        std::vector<unsigned int> visibleCommands;
+        Camera();
+        Camera(SDL_Rect viewport, float zoom);
+        glm::vec2 GetViewSize() const;
+        glm::vec2 GetCenter() const;
+        SDL_FRect WorldToScreen(const SDL_FRect& world) const;
+        bool IsVisible(const SDL_FRect& world) const;
+        bool HasLayer(unsigned int layer) const;
+        void CenterOn(const glm::vec2& target);
+        void Follow(const glm::vec2& target, float deltaTime);
+        void ClampTo(const SDL_Rect& worldBounds);
+};
+
+#endif
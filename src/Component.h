@@ -3,6 +3,10 @@
 
 class Entity;
 
+// Update runs on job system workers alongside other entities' components, so by default it may only write
+// to its own entity and read shared state that nothing writes during a tick (input, assets). Components that
+// call into shared systems such as audio or particles return false from IsParallelSafe, they are updated
+// afterwards one at a time on the simulation thread
 class Component {
     public:
         Entity* owner;
@@ -10,6 +14,7 @@ class Component {
         virtual void Initialize() {};
         virtual void Update(float deltaTime) {};
         virtual void Render() {};
+        virtual bool IsParallelSafe() const { return true; };
 
 };
 
@@ -0,0 +1,73 @@
+#ifndef ANIMATORCOMPONENT_H
+#define ANIMATORCOMPONENT_H
+
+#include <string>
+#include <iostream>
+#include "../EntityManager.h"
+#include "../AssetManager.h"
+#include "../AnimationGraph.h"
+#include "../Game.h"
+#include "./TransformComponent.h"
+#include "./SpriteComponent.h"
+#include "./KeyboardControlComponent.h"
+
+// drives the sprite's source rectangle from a compiled animation graph, the state lives here
+// and is evaluated in batch by EntityManager
+class AnimatorComponent: public Component {
+    private:
+        const AnimationGraph* graph;
+        TransformComponent* transform;
+        SpriteComponent* sprite;
+        bool hasInput;
+    public:
+        unsigned int clip = 0;
+        unsigned int frame = 0;
+        float elapsed = 0.0f;
+        unsigned char isFinished = 0;
+
+        AnimatorComponent(std::string animationAssetId) {
+            graph = Game::assetManager->GetAnimationGraph(animationAssetId);
+            if (!graph) {
+                std::cerr << "Unknown animation asset " << animationAssetId << std::endl;
+            }
+            transform = NULL;
+            sprite = NULL;
+            hasInput = false;
+        }
+
+        void Initialize() override {
+            transform = owner->GetComponent<TransformComponent>();
+            sprite = owner->GetComponent<SpriteComponent>();
+            hasInput = owner->HasComponent<KeyboardControlComponent>();
+            ApplyFrame();
+        }
+
+        const AnimationGraph* GetGraph() const {
+            return graph;
+        }
+
+        const glm::vec2& GetVelocity() const {
+            return transform->velocity;
+        }
+
+        bool HasInput() const {
+            return hasInput;
+        }
+
+        bool IsReady() const {
+            return graph && transform && sprite;
+        }
+
+        void ApplyFrame() {
+            if (IsReady()) {
+                sprite->SetSourceRectangle(graph->GetSource(clip, frame));
+            }
+        }
+
+        // frame events name sound assets and are played where the entity is
+        void OnEvent(unsigned int event) {
+            Game::audioManager->PlayAt(event, transform->position);
+        }
+};
+
+#endif
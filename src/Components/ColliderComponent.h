@@ -10,9 +10,8 @@ class ColliderComponent: public Component {
     public: 
         std::string colliderTag;
         SDL_Rect collider;
-        SDL_Rect sourceRectangle;
-        SDL_Rect destinationRectangle;
         TransformComponent* transform;
+        unsigned int transformVersion;
 
         ColliderComponent (
             std::string colliderTag,
@@ -23,24 +22,26 @@ class ColliderComponent: public Component {
         ) {
             this->colliderTag = colliderTag;
             this->collider = {x, y, width, height };
+            this->transform = NULL;
         }
 
         void Initialize() override {
             if (owner->HasComponent<TransformComponent>()) {
                 transform = owner->GetComponent<TransformComponent>();
-                sourceRectangle = {0, 0, transform->width, transform->height};
-                destinationRectangle = {collider.x, collider.y, collider.w, collider.h};
+                transformVersion = transform->version - 1;
             }
         }
 
         void Update(float deltaTime) override {
+            // the collider only changes when the transform moved
+            if (!transform || transform->version == transformVersion) {
+                return;
+            }
+            transformVersion = transform->version;
             collider.x = static_cast<int>(transform->position.x);
             collider.y = static_cast<int>(transform->position.y); 
             collider.w = transform->width;
             collider.h = transform->height;
-
-            destinationRectangle.x = collider.x - Game::camera.x;
-            destinationRectangle.y = collider.y - Game::camera.y;
         }
 
 };
@@ -8,89 +8,58 @@
 
 class KeyboardControlComponent: public Component {
     public: 
-        std::string upKey;
-        std::string downKey;
-        std::string rightKey;
-        std::string leftKey;
-        std::string shootKey;
         TransformComponent* transform;
         SpriteComponent* sprite;
 
         KeyboardControlComponent() {}
 
-        KeyboardControlComponent(
-            std::string upKey,
-            std::string rightKey,
-            std::string downKey,
-            std::string leftKey,
-            std::string shootKey
-        ) {
-            this->upKey = GetSDLKeyStringCode(upKey);
-            this->downKey = GetSDLKeyStringCode(downKey);
-            this->rightKey = GetSDLKeyStringCode(rightKey);
-            this->leftKey = GetSDLKeyStringCode(leftKey);
-            this->shootKey = GetSDLKeyStringCode(shootKey);
-        }
-
-        std::string GetSDLKeyStringCode(std::string key) {
-            if (key.compare("up") == 0) return "1073741906"; 
-            if (key.compare("down") == 0) return "1073741905"; 
-            if (key.compare("left") == 0) return "1073741904"; 
-            if (key.compare("right") == 0) return "1073741903"; 
-            if (key.compare("space") == 0) return "32"; 
-            return std::to_string(static_cast<int>(key[0]));
-        }
-
         void Initialize() override {
             transform = owner->GetComponent<TransformComponent>();
             sprite = owner->GetComponent<SpriteComponent>();
         }
 
         void Update(float deltaTime) override {
-            if (Game::event.type == SDL_KEYDOWN) {
-                std::string keyCode = std::to_string(Game::event.key.keysym.sym);
-                if (keyCode.compare(upKey) == 0) {
-                    transform->velocity.y = -30;
-                    transform->velocity.x = 0;
-                    sprite->Play("UpAnimation");
-                }
-                if (keyCode.compare(downKey) == 0) {
-                    transform->velocity.y = 30;
-                    transform->velocity.x = 0;
-                    sprite->Play("DownAnimation");
-                }
-                if (keyCode.compare(rightKey) == 0) {
-                    transform->velocity.y = 0;
-                    transform->velocity.x = 30;
-                    sprite->Play("RightAnimation");
-                }
-                if (keyCode.compare(leftKey) == 0) {
-                    transform->velocity.y = 0;
-                    transform->velocity.x = -30;
-                    sprite->Play("LeftAnimation");
-                } 
-                if (keyCode.compare(shootKey) == 0) {
-                    //todo
-                }           
+            // key and button bindings are resolved to actions by Game::inputManager
+            InputManager* input = Game::inputManager;
+            if (input->WasActionPressed(constants::ACTION_UP)) {
+                transform->velocity.y = -30;
+                transform->velocity.x = 0;
+                sprite->Play(constants::UP_ANIMATION);
+            }
+            if (input->WasActionPressed(constants::ACTION_DOWN)) {
+                transform->velocity.y = 30;
+                transform->velocity.x = 0;
+                sprite->Play(constants::DOWN_ANIMATION);
+            }
+            if (input->WasActionPressed(constants::ACTION_RIGHT)) {
+                transform->velocity.y = 0;
+                transform->velocity.x = 30;
+                sprite->Play(constants::RIGHT_ANIMATION);
+            }
+            if (input->WasActionPressed(constants::ACTION_LEFT)) {
+                transform->velocity.y = 0;
+                transform->velocity.x = -30;
+                sprite->Play(constants::LEFT_ANIMATION);
+            }
+            if (input->WasActionPressed(constants::ACTION_SHOOT)) {
+                //todo
+            }
+
+            if (input->WasActionReleased(constants::ACTION_UP)) {
+                transform->velocity.y = 0;
+            }
+            if (input->WasActionReleased(constants::ACTION_DOWN)) {
+                transform->velocity.y = 0;
+            }
+            if (input->WasActionReleased(constants::ACTION_RIGHT)) {
+                transform->velocity.x = 0;
+            }
+            if (input->WasActionReleased(constants::ACTION_LEFT)) {
+                transform->velocity.x = 0;
+            }
+            if (input->WasActionReleased(constants::ACTION_SHOOT)) {
+                //todo
             }
-            if (Game::event.type == SDL_KEYUP) {
-                std::string keyCode = std::to_string(Game::event.key.keysym.sym);
-                if (keyCode.compare(upKey) == 0) {
-                    transform->velocity.y = 0;
-                }
-                if (keyCode.compare(downKey) == 0) {
-                    transform->velocity.y = 0;
-                }
-                if (keyCode.compare(rightKey) == 0) {
-                    transform->velocity.x = 0;
-                }
-                if (keyCode.compare(leftKey) == 0) {
-                    transform->velocity.x = 0;
-                }
-                if (keyCode.compare(shootKey) == 0) {
-                    //todo
-                }                            
-            }        
         }
 };
 
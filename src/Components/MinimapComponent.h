@@ -0,0 +1,125 @@
+#ifndef MINIMAPCOMPONENT_H
+#define MINIMAPCOMPONENT_H
+
+#include <algorithm>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../EntityManager.h"
+#include "../Game.h"
+#include "../Map.h"
+#include "../TextureManager.h"
+#include "./TransformComponent.h"
+#include "../../lib/glm/glm.hpp"
+
+extern EntityManager manager;
+
+// the map is baked into a cached texture once, each frame only the blips of the tracked layers are
+// gathered into compact position buffers and drawn together with the view outline in one geometry call
+class MinimapComponent: public Component {
+    private:
+        Map* map;
+        unsigned int layerMask;
+        TransformComponent* transform;
+        SDL_Texture* overview;
+        SDL_Rect area;
+        SDL_Rect overviewSource;
+        std::vector<glm::vec2> blipPositions[constants::NUM_LAYERS];
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+
+        void AddQuad(float x, float y, float w, float h, const SDL_Color& color) {
+            int first = static_cast<int>(vertices.size());
+            vertices.push_back({{x, y}, color, {0.0f, 0.0f}});
+            vertices.push_back({{x + w, y}, color, {0.0f, 0.0f}});
+            vertices.push_back({{x + w, y + h}, color, {0.0f, 0.0f}});
+            vertices.push_back({{x, y + h}, color, {0.0f, 0.0f}});
+            int quad[6] = {first, first + 1, first + 2, first, first + 2, first + 3};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+
+    public:
+        MinimapComponent(Map* map, unsigned int layerMask) {
+            this->map = map;
+            this->layerMask = layerMask;
+            this->transform = NULL;
+            this->overview = NULL;
+        }
+
+        void Initialize() override {
+            transform = owner->GetComponent<TransformComponent>();
+            // keep the map's aspect ratio inside the radar and centre it
+            const SDL_Rect& bounds = map->GetBounds();
+            float fit = std::min(
+                transform->width * transform->scale / std::max(bounds.w, 1),
+                transform->height * transform->scale / std::max(bounds.h, 1)
+            );
+            area.w = static_cast<int>(bounds.w * fit);
+            area.h = static_cast<int>(bounds.h * fit);
+            area.x = static_cast<int>(transform->position.x + (transform->width * transform->scale - area.w) / 2);
+            area.y = static_cast<int>(transform->position.y + (transform->height * transform->scale - area.h) / 2);
+            overview = map->GetOverview(area.w, area.h);
+            overviewSource = {0, 0, area.w, area.h};
+            if (overview) {
+                SDL_SetTextureAlphaMod(overview, constants::MINIMAP_ALPHA);
+            }
+        }
+
+        void Render() override {
+            if (overview) {
+                TextureManager::DrawScreen(overview, overviewSource, area, SDL_FLIP_NONE);
+            }
+            const SDL_Rect& bounds = map->GetBounds();
+            if (bounds.w == 0 || bounds.h == 0) {
+                return;
+            }
+            float scaleX = static_cast<float>(area.w) / bounds.w;
+            float scaleY = static_cast<float>(area.h) / bounds.h;
+
+            for (unsigned int layer = 0; layer < constants::NUM_LAYERS; layer++) {
+                blipPositions[layer].clear();
+                if (!(layerMask & (1u << layer))) {
+                    continue;
+                }
+                for (auto &entity: manager.GetLayerEntities(static_cast<constants::LayerType>(layer))) {
+                    if (entity->IsActive() && entity->HasComponent<TransformComponent>()) {
+                        const TransformComponent* blip = entity->GetComponent<TransformComponent>();
+                        blipPositions[layer].push_back(glm::vec2(
+                            blip->position.x + blip->width * blip->scale * 0.5f,
+                            blip->position.y + blip->height * blip->scale * 0.5f
+                        ));
+                    }
+                }
+            }
+
+            vertices.clear();
+            indices.clear();
+            float halfBlip = constants::MINIMAP_BLIP_SIZE * 0.5f;
+            for (unsigned int layer = 0; layer < constants::NUM_LAYERS; layer++) {
+                for (auto &position: blipPositions[layer]) {
+                    AddQuad(
+                        area.x + position.x * scaleX - halfBlip,
+                        area.y + position.y * scaleY - halfBlip,
+                        constants::MINIMAP_BLIP_SIZE,
+                        constants::MINIMAP_BLIP_SIZE,
+                        constants::MINIMAP_BLIP_COLORS[layer]
+                    );
+                }
+            }
+
+            // outline what the main camera currently shows
+            const Camera& camera = Game::cameras.front();
+            glm::vec2 viewSize = camera.GetViewSize();
+            float viewX = area.x + camera.position.x * scaleX;
+            float viewY = area.y + camera.position.y * scaleY;
+            float viewW = viewSize.x * scaleX;
+            float viewH = viewSize.y * scaleY;
+            AddQuad(viewX, viewY, viewW, 1.0f, constants::WHITE_COLOR);
+            AddQuad(viewX, viewY + viewH - 1.0f, viewW, 1.0f, constants::WHITE_COLOR);
+            AddQuad(viewX, viewY, 1.0f, viewH, constants::WHITE_COLOR);
+            AddQuad(viewX + viewW - 1.0f, viewY, 1.0f, viewH, constants::WHITE_COLOR);
+
+            Game::drawList->AddGeometry(NULL, vertices, indices);
+        }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef PARTICLEEMITTERCOMPONENT_H
+#define PARTICLEEMITTERCOMPONENT_H
+
+#include <string>
+#include "../EntityManager.h"
+#include "../AssetManager.h"
+#include "../ParticleSystem.h"
+#include "../Game.h"
+#include "./TransformComponent.h"
+#include "../../lib/glm/glm.hpp"
+
+// spawns particles from the owner's position, the particles themselves live in Game::particleSystem
+class ParticleEmitterComponent: public Component {
+    private:
+        unsigned int emitter;
+        glm::vec2 offset;
+        float pending;
+        TransformComponent* transform;
+    public:
+        ParticleEmitterComponent(std::string particleAssetId, glm::vec2 offset) {
+            this->emitter = Game::assetManager->GetParticleEmitter(particleAssetId);
+            this->offset = offset;
+            this->pending = 0.0f;
+            this->transform = NULL;
+        }
+
+        void Initialize() override {
+            transform = owner->GetComponent<TransformComponent>();
+            if (emitter != constants::NO_PARTICLE_EMITTER) {
+                Game::particleSystem->Emit(emitter, transform->position + offset, Game::particleSystem->GetDefinition(emitter).burst);
+            }
+        }
+
+        bool IsParallelSafe() const override {
+            return false;
+        }
+
+        void Update(float deltaTime) override {
+            if (emitter == constants::NO_PARTICLE_EMITTER) {
+                return;
+            }
+            pending += Game::particleSystem->GetDefinition(emitter).rate * deltaTime;
+            unsigned int spawnCount = static_cast<unsigned int>(pending);
+            pending -= spawnCount;
+            Game::particleSystem->Emit(emitter, transform->position + offset, spawnCount);
+        }
+};
+
+#endif
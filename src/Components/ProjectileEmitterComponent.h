@@ -30,16 +30,27 @@ class ProjectileEmitterComponent: public Component {
             transform = owner->GetComponent<TransformComponent>();
             origin = glm::vec2(transform->position.x, transform->position.y);
             transform->velocity = glm::vec2(glm::cos(angleRad) * speed, glm::sin(angleRad) * speed);
+            // projectiles are drawn pointing along their flight path
+            transform->rotation = glm::degrees(angleRad);
         }
 
-        void Update(float deltaTime) override {
-            if (glm::distance(transform->position, origin) > range) {
-                if (shouldLoop) {
-                    transform->position.x = origin.x;
-                    transform->position.y = origin.y;
-                } else {
-                    owner->Destroy();
-                }
+        const glm::vec2& GetOrigin() const {
+            return origin;
+        }
+
+        int GetRange() const {
+            return range;
+        }
+
+        // called by EntityManager once the projectile travelled past its range
+        void OnOutOfRange() {
+            if (shouldLoop) {
+                transform->position.x = origin.x;
+                transform->position.y = origin.y;
+                transform->previousPosition = origin;
+                transform->version++;
+            } else {
+                owner->Destroy();
             }
         }
 
@@ -0,0 +1,78 @@
+#ifndef SOUNDCOMPONENT_H
+#define SOUNDCOMPONENT_H
+
+#include <string>
+#include "../Component.h"
+#include "../EntityManager.h"
+#include "../AssetManager.h"
+#include "../AudioManager.h"
+#include "../Game.h"
+#include "./TransformComponent.h"
+
+class SoundComponent: public Component {
+    private:
+        unsigned int soundId;
+        bool isLooping;
+        int voice;
+        TransformComponent* transform;
+        unsigned int transformVersion;
+        glm::vec2 listenerCenter;
+        glm::vec2 listenerViewSize;
+    public:
+        SoundComponent(std::string soundAssetId, bool isLooping) {
+            this->soundId = Game::assetManager->GetSound(soundAssetId);
+            this->isLooping = isLooping;
+            this->voice = -1;
+            this->transform = NULL;
+            this->transformVersion = 0;
+        }
+
+        ~SoundComponent() {
+            if (isLooping) {
+                Game::audioManager->Stop(voice, soundId);
+            }
+        }
+
+        void Initialize() override {
+            if (owner->HasComponent<TransformComponent>()) {
+                transform = owner->GetComponent<TransformComponent>();
+                transformVersion = transform->version;
+                listenerCenter = Game::cameras.front().GetCenter();
+                listenerViewSize = Game::cameras.front().GetViewSize();
+                voice = Game::audioManager->PlayAt(soundId, transform->position, isLooping ? -1 : 0);
+            } else {
+                voice = Game::audioManager->Play(soundId, isLooping ? -1 : 0);
+            }
+        }
+
+        bool IsParallelSafe() const override {
+            return false;
+        }
+
+        // a looping voice stops with its entity, pan and distance are only recomputed when the emitter
+        // or the listening camera moved since the last update
+        void Update(float deltaTime) override {
+            if (!owner->IsActive()) {
+                if (isLooping) {
+                    Game::audioManager->Stop(voice, soundId);
+                }
+                voice = -1;
+                return;
+            }
+            if (!transform) {
+                return;
+            }
+            const Camera& camera = Game::cameras.front();
+            glm::vec2 center = camera.GetCenter();
+            glm::vec2 viewSize = camera.GetViewSize();
+            if (transform->version == transformVersion && center == listenerCenter && viewSize == listenerViewSize) {
+                return;
+            }
+            transformVersion = transform->version;
+            listenerCenter = center;
+            listenerViewSize = viewSize;
+            Game::audioManager->SetVoicePosition(voice, soundId, transform->position);
+        }
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef SPRITECOMPONENT_H
 #define SPRITECOMPONENT_H
 
+#include <algorithm>
+#include <vector>
 #include<SDL2/SDL.h>
 #include "../TextureManager.h"
 #include "../AssetManager.h"
@@ -13,64 +15,94 @@ class SpriteComponent: public Component {
         TransformComponent* transform;
         SDL_Texture* texture;
         SDL_Rect sourceRectangle;
-        SDL_Rect desitinationRectangle;
+        SDL_FRect desitinationRectangle;
         bool isAnimated;
         int numFrames;
         int animationSpeed;
+        unsigned int numAnimations;
         bool isFixed;
-        std::map<std::string, Animation> animations;
-        std::string currentAnimationName;
-        unsigned int animationIndex = 0;
+        std::vector<SDL_Rect> frames;
+        std::vector<Animation> animations;
+        unsigned int currentAnimation = 0;
+        int frameWidth = 0;
+        int frameHeight = 0;
+        unsigned int transformVersion;
+
+        // one row of the sheet per animation, every source rectangle is computed here instead of per frame
+        void BuildFrames() {
+            frameWidth = transform->width;
+            frameHeight = transform->height;
+            frames.clear();
+            animations.clear();
+            for (unsigned int row = 0; row < numAnimations; row++) {
+                animations.emplace_back(frames.size(), numFrames, animationSpeed / 1000.0f);
+                for (int frame = 0; frame < numFrames; frame++) {
+                    frames.push_back({frame * frameWidth, static_cast<int>(row) * frameHeight, frameWidth, frameHeight});
+                }
+            }
+            SetFrame(std::min(animationFrame, animations[currentAnimation].numFrames - 1));
+        }
 
     public:
         SDL_RendererFlip spriteFlip = SDL_FLIP_NONE;
+        // advanced in batch by EntityManager on the simulation clock
+        unsigned int animationFrame = 0;
+        float animationElapsed = 0.0f;
 
         SpriteComponent(std::string assetTextureId) {
             this->isAnimated = false;
             this->isFixed = false;
+            this->numFrames = 1;
+            this->animationSpeed = 0;
+            this->numAnimations = 1;
             SetTexture(assetTextureId);
         }
 
         SpriteComponent(std::string assetTextureId, bool isFixed) {
             this->isAnimated = false;
             this->isFixed = isFixed;
+            this->numFrames = 1;
+            this->animationSpeed = 0;
+            this->numAnimations = 1;
             SetTexture(assetTextureId);
         }
 
         SpriteComponent(std::string id, int numFrames, int animationSpeed, bool hasDirections, bool isFixed) {
             this->isAnimated = true;
-            this->numFrames = numFrames;
+            this->numFrames = std::max(numFrames, 1);
             this->animationSpeed = animationSpeed;
             this->isFixed = isFixed;
-            if (hasDirections) {
-                Animation downAnimation = Animation(0, numFrames, animationSpeed);
-                Animation rightAnimation = Animation(1, numFrames, animationSpeed);
-                Animation leftAnimation = Animation(2, numFrames, animationSpeed);
-                Animation upAnimation = Animation(3, numFrames, animationSpeed);
+            // directional sheets hold one row per constants::AnimationId
+            this->numAnimations = hasDirections ? constants::NUM_DIRECTIONS : 1;
+            SetTexture(id);
+        }
 
-                animations.emplace("DownAnimation", downAnimation);
-                animations.emplace("RightAnimation", rightAnimation);
-                animations.emplace("LeftAnimation", leftAnimation);
-                animations.emplace("UpAnimation", upAnimation);
+        bool IsAnimated() const {
+            return isAnimated;
+        }
 
-                animationIndex = 0;
-                currentAnimationName = "DownAnimation";
+        const Animation& GetCurrentAnimation() const {
+            return animations[currentAnimation];
+        }
 
-            } else {
-                Animation singleAnimation = Animation(0, numFrames, animationSpeed);
-                animations.emplace("SingleAnimation", singleAnimation);
-                animationIndex = 0;
-                currentAnimationName = "SingleAnimation";
+        void Play(unsigned int animationId) {
+            if (animationId == currentAnimation || animationId >= numAnimations) {
+                return;
             }
-            Play(currentAnimationName);
-            SetTexture(id);
+            currentAnimation = animationId;
+            animationElapsed = 0.0f;
+            SetFrame(0);
         }
 
-        void Play(std::string animationName) {
-            numFrames = animations[animationName].numFrames;
-            animationIndex = animations[animationName].index;
-            animationSpeed = animations[animationName].animationSpeed;
-            currentAnimationName = animationName;
+        void SetSourceRectangle(const SDL_Rect& source) {
+            sourceRectangle = source;
+        }
+
+        void SetFrame(unsigned int frame) {
+            animationFrame = frame;
+            if (!frames.empty()) {
+                sourceRectangle = frames[animations[currentAnimation].firstFrame + frame];
+            }
         }
 
         void SetTexture(std::string assetTextureId) {
@@ -79,25 +111,39 @@ class SpriteComponent: public Component {
 
         void Initialize() override {
             transform = owner->GetComponent<TransformComponent>();
-            sourceRectangle.x = 0;
-            sourceRectangle.y = 0;
-            sourceRectangle.w = transform->width;
-            sourceRectangle.h = transform->height;
+            SyncWithTransform();
         }
 
-        void Update(float deltaTime) override {
-            if (isAnimated) {
-                sourceRectangle.x = sourceRectangle.w * static_cast<int>((SDL_GetTicks() / animationSpeed) % numFrames);
+        void SyncWithTransform() {
+            if (transform->width != frameWidth || transform->height != frameHeight) {
+                BuildFrames();
             }
-            sourceRectangle.y = animationIndex * transform->height;
-            desitinationRectangle.x = static_cast<int>(transform->position.x) - (isFixed ? 0 : Game::camera.x);
-            desitinationRectangle.y = static_cast<int>(transform->position.y) - (isFixed ? 0 : Game::camera.y);
             desitinationRectangle.w = transform->width * transform->scale;
             desitinationRectangle.h = transform->height * transform->scale;
+            transformVersion = transform->version;
+        }
+
+        void Update(float deltaTime) override {
+            if (transform->version != transformVersion) {
+                SyncWithTransform();
+            }
         }
 
         void Render() override {
-            TextureManager::Draw(texture, sourceRectangle, desitinationRectangle, spriteFlip);
+            glm::vec2 renderPosition = transform->GetInterpolatedPosition(Game::interpolationAlpha);
+            desitinationRectangle.x = renderPosition.x;
+            desitinationRectangle.y = renderPosition.y;
+            if (isFixed) {
+                SDL_Rect screenRectangle = {
+                    static_cast<int>(desitinationRectangle.x),
+                    static_cast<int>(desitinationRectangle.y),
+                    static_cast<int>(desitinationRectangle.w),
+                    static_cast<int>(desitinationRectangle.h)
+                };
+                TextureManager::DrawScreen(texture, sourceRectangle, screenRectangle, spriteFlip);
+            } else {
+                TextureManager::Draw(texture, sourceRectangle, desitinationRectangle, spriteFlip, transform->rotation, {transform->pivot.x, transform->pivot.y});
+            }
         }
 };
 
@@ -3,7 +3,10 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
 #include "../FontManager.h"
+#include "../GlyphAtlas.h"
 #include "../EntityManager.h"
 #include "../AssetManager.h"
 #include "../Game.h"
@@ -14,7 +17,9 @@ class TextLabelCompnent: public Component {
         std::string text;
         std::string fontFamily;
         SDL_Color color;
-        SDL_Texture* texture;
+        GlyphAtlas* glyphAtlas;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
     public:
         TextLabelCompnent(
             int x, 
@@ -25,26 +30,32 @@ class TextLabelCompnent: public Component {
         ) {
             this->position.x = x;
             this->position.y = y;
-            this->text = text;
-            this->fontFamily = fontFamily;
             this->color = color;
+            this->glyphAtlas = NULL;
             SetLabelText(text, fontFamily);
         }
 
-        void SetLabelText(std::string text, std::string fontFamiliy) {
-            SDL_Surface* surface = TTF_RenderText_Blended(
-                Game::assetManager->GetFont(fontFamiliy),
-                text.c_str(),
-                color
-            );
-            texture = SDL_CreateTextureFromSurface(Game::renderer, surface);
-            SDL_FreeSurface(surface);
-            SDL_QueryTexture(texture, NULL, NULL, &position.w, &position.h);
-
+        // the quads are only rebuilt when the text or font actually changes, and reuse the vertex storage when they are
+        void SetLabelText(const std::string& text, const std::string& fontFamiliy) {
+            if (glyphAtlas && text == this->text && fontFamiliy == this->fontFamily) {
+                return;
+            }
+            this->text = text;
+            this->fontFamily = fontFamiliy;
+            if (!Game::renderer) {
+                return;
+            }
+            glyphAtlas = Game::assetManager->GetGlyphAtlas(fontFamiliy);
+            float scale = Game::assetManager->GetFontScale(fontFamiliy);
+            SDL_Rect bounds = glyphAtlas->Layout(text, position.x, position.y, scale, color, vertices, indices);
+            position.w = bounds.w;
+            position.h = bounds.h;
         }
 
         void Render() override {
-            FontManager::Draw(texture, position);
+            if (glyphAtlas) {
+                glyphAtlas->Draw(vertices, indices);
+            }
         }
 };
 
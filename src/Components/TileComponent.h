@@ -10,7 +10,7 @@ class TileComponent: public Component {
     public:
         SDL_Texture* texture;
         SDL_Rect sourceRectangle;
-        SDL_Rect destinationRectangle;
+        SDL_FRect destinationRectangle;
         glm::vec2 position;
 
         TileComponent(int sourceRectX, int sourceRectY, int x, int y, int tileSize, int tileScale, std::string assetTextureId) {
@@ -34,13 +34,6 @@ class TileComponent: public Component {
             SDL_DestroyTexture(texture);
         }
 
-        void Update(float deltaTime) override {
-            //todo here is where we will take care of the position
-            // based on the camera control that will keep moving around
-            destinationRectangle.x = position.x - Game::camera.x;
-            destinationRectangle.y = position.y - Game::camera.y;
-        }
-
         void Render() override {
             TextureManager::Draw(texture, sourceRectangle, destinationRectangle, SDL_FLIP_NONE);
         }
@@ -9,17 +9,30 @@
 class TransformComponent: public Component {
     public:
         glm::vec2 position;
+        glm::vec2 previousPosition;
         glm::vec2 velocity;
         int width;
         int height;
-        int scale;
-
-        TransformComponent(int posX, int posY, int velX, int velY, int w, int h, int s) {
+        float scale;
+        // degrees clockwise around the pivot, which is a fraction of the scaled size
+        float rotation;
+        glm::vec2 pivot;
+        // bumped whenever position or size changes so dependent components can skip resyncing
+        unsigned int version = 0;
+
+        TransformComponent(int posX, int posY, int velX, int velY, int w, int h, float s, float r = 0.0f) {
             position = glm::vec2(posX, posY);
+            previousPosition = position;
             velocity = glm::vec2(velX, velY);
             width = w;
             height = h;
             scale = s;
+            rotation = r;
+            pivot = glm::vec2(0.5f, 0.5f);
+        }
+
+        glm::vec2 GetInterpolatedPosition(float alpha) const {
+            return glm::mix(previousPosition, position, alpha);
         }
 
         void Initialize() override {
@@ -27,8 +40,7 @@ class TransformComponent: public Component {
         }
 
         void Update(float deltaTime) override {
-            position.x += velocity.x * deltaTime;
-            position.y += velocity.y * deltaTime;
+            // position is integrated in batch by EntityManager
         }
 
         void Render() override {
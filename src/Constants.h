@@ -8,7 +8,33 @@ namespace constants {
     const unsigned int WINDOW_HEIGHT = 600;
 
     const unsigned int FPS = 60;
-    const unsigned int FRAME_TARGET_TIME = 1000 / FPS;
+    const unsigned int FRAME_HISTORY_SIZE = 240;
+    const double FRAME_SPIN_THRESHOLD = 0.002;
+    const double STUTTER_FACTOR = 1.5;
+
+    const unsigned int INPUT_EVENT_CAPACITY = 64;
+
+    enum ActionType {
+        ACTION_UP,
+        ACTION_RIGHT,
+        ACTION_DOWN,
+        ACTION_LEFT,
+        ACTION_SHOOT,
+        NUM_ACTIONS
+    };
+
+    const char* const ACTION_NAMES[NUM_ACTIONS] = {"up", "right", "down", "left", "shoot"};
+
+    const unsigned char NO_ACTION = 0xFF;
+
+    const unsigned int TICK_RATE = 60;
+    const float MAX_FRAME_TIME = 0.25f;
+
+    enum FrameMode {
+        FRAME_CAPPED,
+        FRAME_UNCAPPED,
+        FRAME_VSYNC
+    };
 
     enum CollisionType {
         NO_COLLISION,
@@ -31,9 +57,72 @@ namespace constants {
 
     const unsigned int NUM_LAYERS = 7;
 
+    const char* const LAYER_NAMES[NUM_LAYERS] = {"tilemap", "vegetation", "enemy", "player", "projectile", "ui", "obstacle"};
+
+    enum AnimationId {
+        DOWN_ANIMATION,
+        RIGHT_ANIMATION,
+        LEFT_ANIMATION,
+        UP_ANIMATION,
+        NUM_DIRECTIONS
+    };
+
     const SDL_Color WHITE_COLOR = {255, 255, 255, 255};
 
     const SDL_Color GREEN_COLOR = {0, 255, 0, 255};
+
+    // particles are drawn after every entity layer and can be masked per camera like one
+    const unsigned int PARTICLE_LAYER = NUM_LAYERS;
+    const unsigned int PARTICLE_CAPACITY = 131072;
+    const unsigned int PARTICLE_SEED = 7919;
+    const int PARTICLE_TEXTURE_SIZE = 32;
+    const unsigned int NO_PARTICLE_EMITTER = 0xFFFFFFFF;
+
+    const float CAMERA_SMOOTHING_TIME = 0.08f;
+    const unsigned int ALL_LAYERS = 0xFFFFFFFF;
+
+    const Uint8 MINIMAP_ALPHA = 160;
+    const float MINIMAP_BLIP_SIZE = 3.0f;
+    const unsigned int MINIMAP_DEFAULT_LAYERS = (1u << ENEMY_LAYER) | (1u << PLAYER_LAYER) | (1u << PROJECTILE_LAYER);
+    const SDL_Color MINIMAP_BLIP_COLORS[NUM_LAYERS] = {
+        {0, 0, 0, 0},
+        {40, 160, 40, 255},
+        {255, 60, 60, 255},
+        {255, 220, 0, 255},
+        {0, 255, 0, 255},
+        {255, 255, 255, 255},
+        {255, 255, 255, 255}
+    };
+
+    const unsigned int AUDIO_VOICE_COUNT = 16;
+    const int AUDIO_CHUNK_SIZE = 1024;
+    const float AUDIO_MAX_DISTANCE = 800.0f;
+    const unsigned int NO_SOUND = 0xFFFFFFFF;
+    const int DEFAULT_SOUND_PRIORITY = 0;
+    const unsigned int DEFAULT_SOUND_VOICES = 4;
+
+    const unsigned int MUSIC_RING_SAMPLES = 32768;
+    const unsigned int MUSIC_BLOCK_BYTES = 4096;
+    const int MUSIC_DECODE_INTERVAL_MS = 5;
+    const int MUSIC_FADE_MS = 1000;
+
+    const unsigned int GLYPH_ATLAS_SIZE = 512;
+    const Uint16 FIRST_GLYPH = 32;
+    const Uint16 GLYPH_COUNT = 256;
+    const int SCALABLE_FONT_SIZE = 48;
+
+    const unsigned int MAX_METRICS = 64;
+
+    const unsigned int PROFILER_ZONE_CAPACITY = 16384;
+    const unsigned int PROFILER_FRAME_HISTORY = 120;
+    const unsigned int PROFILER_MAX_ZONE_NAMES = 64;
+    const unsigned int PROFILER_MAX_COUNTERS = 64;
+    const unsigned int PROFILER_OVERLAY_LINES = 9;
+    const unsigned int PROFILER_OVERLAY_REFRESH_FRAMES = 15;
+    const char* const PROFILER_FONT_FILE = "./assets/fonts/arial.ttf";
+    const int PROFILER_FONT_SIZE = 12;
+    const int PROFILER_PANEL_X = 8;
+    const int PROFILER_PANEL_Y = 8;
 }
 
 #endif
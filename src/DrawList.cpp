@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cmath>
+#include "./DrawList.h"
+#include "./Game.h"
+#include "./Profiler.h"
+#include "./TextureManager.h"
+#include "../lib/glm/glm.hpp"
+
+DrawList::DrawList(): layer(0), batchTexture(NULL), batchTextureSize({1.0f, 1.0f}) {
+}
+
+void DrawList::Clear() {
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+    sortKeys.clear();
+    layer = 0;
+}
+
+void DrawList::SetLayer(unsigned int layer) {
+    this->layer = layer;
+}
+
+void DrawList::Add(SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& worldRectangle, SDL_RendererFlip flip, float angle, SDL_FPoint pivot) {
+    commands.push_back({texture, source, worldRectangle, flip, angle, pivot, layer, false, false, false, 0, 0, 0, 0});
+}
+
+void DrawList::AddScreen(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& screenRectangle, SDL_RendererFlip flip) {
+    SDL_FRect destination = {
+        static_cast<float>(screenRectangle.x),
+        static_cast<float>(screenRectangle.y),
+        static_cast<float>(screenRectangle.w),
+        static_cast<float>(screenRectangle.h)
+    };
+    commands.push_back({texture, source, destination, flip, 0.0f, {0.5f, 0.5f}, layer, true, false, false, 0, 0, 0, 0});
+}
+
+// the vertices and indices are copied into the list, a NULL texture draws flat colours
+void DrawList::AddGeometry(SDL_Texture* texture, const std::vector<SDL_Vertex>& vertices, const std::vector<int>& indices) {
+    if (indices.empty()) {
+        return;
+    }
+    SDL_Rect noSource = {0, 0, 0, 0};
+    SDL_FRect noDestination = {0.0f, 0.0f, 0.0f, 0.0f};
+    commands.push_back({
+        texture, noSource, noDestination, SDL_FLIP_NONE, 0.0f, {0.5f, 0.5f}, layer, true, true, false,
+        static_cast<unsigned int>(this->vertices.size()), static_cast<int>(vertices.size()),
+        static_cast<unsigned int>(this->indices.size()), static_cast<int>(indices.size())
+    });
+    this->vertices.insert(this->vertices.end(), vertices.begin(), vertices.end());
+    this->indices.insert(this->indices.end(), indices.begin(), indices.end());
+}
+
+// world quads keep world positions and their bounds are what cameras cull against, the caller fills
+// four vertices per quad in place before the next Add and the two triangles are shared by every quad list
+SDL_Vertex* DrawList::AddWorldQuads(SDL_Texture* texture, unsigned int quadCount, const SDL_FRect& bounds) {
+    if (quadCount == 0) {
+        return NULL;
+    }
+    if (quadIndices.size() < quadCount * 6) {
+        unsigned int quads = quadIndices.size() / 6;
+        quadIndices.resize(quadCount * 6);
+        for (unsigned int quad = quads; quad < quadCount; quad++) {
+            int first = quad * 4;
+            int* index = &quadIndices[quad * 6];
+            index[0] = first;
+            index[1] = first + 1;
+            index[2] = first + 2;
+            index[3] = first;
+            index[4] = first + 2;
+            index[5] = first + 3;
+        }
+    }
+    SDL_Rect noSource = {0, 0, 0, 0};
+    unsigned int firstVertex = vertices.size();
+    commands.push_back({
+        texture, noSource, bounds, SDL_FLIP_NONE, 0.0f, {0.5f, 0.5f}, layer, false, true, true,
+        firstVertex, static_cast<int>(quadCount * 4), 0, static_cast<int>(quadCount * 6)
+    });
+    vertices.resize(firstVertex + quadCount * 4);
+    return &vertices[firstVertex];
+}
+
+unsigned int DrawList::GetCount() const {
+    return commands.size();
+}
+
+// keys pack layer (8 bits) | texture (32 bits) | sequence (24 bits) so one sort orders every command
+// by layer and groups textures for batching, screen commands leave the texture out to keep submission order
+uint64_t DrawList::GetSortKey(const DrawCommand& command, unsigned int sequence) {
+    uint64_t textureKey = command.isScreenSpace ? 0 : static_cast<uint32_t>(reinterpret_cast<uintptr_t>(command.texture) >> 4);
+    return (static_cast<uint64_t>(command.layer & 0xFF) << 56) | (textureKey << 24) | (sequence & 0xFFFFFF);
+}
+
+void DrawList::Sort() {
+    sortKeys.resize(commands.size());
+    for (unsigned int i = 0; i < commands.size(); i++) {
+        sortKeys[i] = GetSortKey(commands[i], i);
+    }
+    std::sort(sortKeys.begin(), sortKeys.end());
+}
+
+// a rotated quad can reach past its rectangle, so it is culled by the circle around its pivot
+SDL_FRect DrawList::GetBounds(const DrawCommand& command) {
+    if (command.angle == 0.0f || command.isGeometry) {
+        return command.destination;
+    }
+    const SDL_FRect& rectangle = command.destination;
+    float pivotX = rectangle.w * command.pivot.x;
+    float pivotY = rectangle.h * command.pivot.y;
+    float reachX = std::max(pivotX, rectangle.w - pivotX);
+    float reachY = std::max(pivotY, rectangle.h - pivotY);
+    float radius = std::sqrt(reachX * reachX + reachY * reachY);
+    return {rectangle.x + pivotX - radius, rectangle.y + pivotY - radius, radius * 2.0f, radius * 2.0f};
+}
+
+// the list keeps its own copy of the cameras so the views it was culled for are the ones it is drawn with
+void DrawList::Cull(const std::vector<Camera>& cameras) {
+    this->cameras = cameras;
+    for (auto &camera: this->cameras) {
+        camera.visibleCommands.clear();
+        for (auto &key: sortKeys) {
+            unsigned int index = key & 0xFFFFFF;
+            const DrawCommand& command = commands[index];
+            if (!command.isScreenSpace && camera.HasLayer(command.layer) && camera.IsVisible(GetBounds(command))) {
+                camera.visibleCommands.push_back(index);
+            }
+        }
+    }
+}
+
+const char* DrawList::GetLayerName(unsigned int layer) {
+    return layer < constants::NUM_LAYERS ? constants::LAYER_NAMES[layer] : "particles";
+}
+
+// visible commands are in key order, so each layer is one contiguous run and gets its own profiler zone
+void DrawList::Draw() const {
+    for (auto &camera: cameras) {
+        SDL_RenderSetClipRect(Game::renderer, &camera.viewport);
+        const std::vector<unsigned int>& visible = camera.visibleCommands;
+        unsigned int i = 0;
+        while (i < visible.size()) {
+            unsigned int layer = commands[visible[i]].layer;
+            PROFILE_ZONE(GetLayerName(layer));
+            for (; i < visible.size() && commands[visible[i]].layer == layer; i++) {
+                Submit(commands[visible[i]], &camera);
+            }
+            FlushBatch();
+        }
+        SDL_RenderSetClipRect(Game::renderer, NULL);
+    }
+}
+
+void DrawList::DrawScreen() const {
+    for (auto &key: sortKeys) {
+        const DrawCommand& command = commands[key & 0xFFFFFF];
+        if (command.isScreenSpace) {
+            Submit(command, NULL);
+        }
+    }
+    FlushBatch();
+}
+
+// consecutive sprites sharing a texture become one geometry call, rotation and flipping are applied
+// to the quad's corners and texture coordinates instead of costing a call each
+void DrawList::AppendQuad(const DrawCommand& command, const Camera* camera) const {
+    if (command.texture != batchTexture) {
+        FlushBatch();
+        int width = 1;
+        int height = 1;
+        SDL_QueryTexture(command.texture, NULL, NULL, &width, &height);
+        batchTexture = command.texture;
+        batchTextureSize = {static_cast<float>(width), static_cast<float>(height)};
+    }
+    SDL_FRect rectangle = camera ? camera->WorldToScreen(command.destination) : command.destination;
+    float u0 = command.source.x / batchTextureSize.x;
+    float v0 = command.source.y / batchTextureSize.y;
+    float u1 = (command.source.x + command.source.w) / batchTextureSize.x;
+    float v1 = (command.source.y + command.source.h) / batchTextureSize.y;
+    if (command.flip & SDL_FLIP_HORIZONTAL) {
+        std::swap(u0, u1);
+    }
+    if (command.flip & SDL_FLIP_VERTICAL) {
+        std::swap(v0, v1);
+    }
+    float pivotX = rectangle.x + rectangle.w * command.pivot.x;
+    float pivotY = rectangle.y + rectangle.h * command.pivot.y;
+    float cornersX[4] = {rectangle.x, rectangle.x + rectangle.w, rectangle.x + rectangle.w, rectangle.x};
+    float cornersY[4] = {rectangle.y, rectangle.y, rectangle.y + rectangle.h, rectangle.y + rectangle.h};
+    if (command.angle != 0.0f) {
+        float radians = glm::radians(command.angle);
+        float cosine = std::cos(radians);
+        float sine = std::sin(radians);
+        for (int corner = 0; corner < 4; corner++) {
+            float offsetX = cornersX[corner] - pivotX;
+            float offsetY = cornersY[corner] - pivotY;
+            cornersX[corner] = pivotX + offsetX * cosine - offsetY * sine;
+            cornersY[corner] = pivotY + offsetX * sine + offsetY * cosine;
+        }
+    }
+    const SDL_Color white = {255, 255, 255, 255};
+    int first = static_cast<int>(batchVertices.size());
+    batchVertices.push_back({{cornersX[0], cornersY[0]}, white, {u0, v0}});
+    batchVertices.push_back({{cornersX[1], cornersY[1]}, white, {u1, v0}});
+    batchVertices.push_back({{cornersX[2], cornersY[2]}, white, {u1, v1}});
+    batchVertices.push_back({{cornersX[3], cornersY[3]}, white, {u0, v1}});
+    int quad[6] = {first, first + 1, first + 2, first, first + 2, first + 3};
+    batchIndices.insert(batchIndices.end(), quad, quad + 6);
+}
+
+void DrawList::FlushBatch() const {
+    if (!batchIndices.empty()) {
+        SDL_RenderGeometry(Game::renderer, batchTexture, batchVertices.data(), static_cast<int>(batchVertices.size()), batchIndices.data(), static_cast<int>(batchIndices.size()));
+        TextureManager::CountDrawCall(batchTexture);
+    }
+    batchVertices.clear();
+    batchIndices.clear();
+    batchTexture = NULL;
+}
+
+void DrawList::Submit(const DrawCommand& command, const Camera* camera) const {
+    if (!command.isGeometry) {
+        if (command.texture) {
+            AppendQuad(command, camera);
+        }
+        return;
+    }
+    FlushBatch();
+    const SDL_Vertex* commandVertices = &vertices[command.firstVertex];
+    const int* commandIndices = command.isQuadList ? quadIndices.data() : &indices[command.firstIndex];
+    if (camera && !command.isScreenSpace) {
+        cameraVertices.resize(command.vertexCount);
+        for (int i = 0; i < command.vertexCount; i++) {
+            cameraVertices[i] = commandVertices[i];
+            cameraVertices[i].position.x = camera->viewport.x + (commandVertices[i].position.x - camera->position.x) * camera->zoom;
+            cameraVertices[i].position.y = camera->viewport.y + (commandVertices[i].position.y - camera->position.y) * camera->zoom;
+        }
+        SDL_RenderGeometry(Game::renderer, command.texture, cameraVertices.data(), command.vertexCount, commandIndices, command.indexCount);
+    } else {
+        SDL_RenderGeometry(Game::renderer, command.texture, commandVertices, command.vertexCount, commandIndices, command.indexCount);
+    }
+    TextureManager::CountDrawCall(command.texture);
+}
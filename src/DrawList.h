@@ -0,0 +1,67 @@
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <vector>
+#include <cstdint>
+#include <SDL2/SDL.h>
+#include "./Camera.h"
+
+// world commands are culled and mapped per camera, screen commands are drawn once over every view,
+// angles are in degrees clockwise around a pivot given as a fraction of the destination size,
+// geometry lives in the list's own vertex and index storage so a recorded frame outlives its producers
+struct DrawCommand {
+    SDL_Texture* texture;
+    SDL_Rect source;
+    SDL_FRect destination;
+    SDL_RendererFlip flip;
+    float angle;
+    SDL_FPoint pivot;
+    unsigned int layer;
+    bool isScreenSpace;
+    bool isGeometry;
+    bool isQuadList;
+    unsigned int firstVertex;
+    int vertexCount;
+    unsigned int firstIndex;
+    int indexCount;
+};
+
+// components submit their draws here once per frame, every camera then replays the same list
+// so extra views cost a cull and a submit rather than another pass over the entities,
+// a list is recorded and culled on the simulation thread and drawn later on the render thread
+class DrawList {
+    private:
+        std::vector<DrawCommand> commands;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        std::vector<int> quadIndices;
+        std::vector<uint64_t> sortKeys;
+        std::vector<Camera> cameras;
+        unsigned int layer;
+        mutable std::vector<SDL_Vertex> cameraVertices;
+        mutable std::vector<SDL_Vertex> batchVertices;
+        mutable std::vector<int> batchIndices;
+        mutable SDL_Texture* batchTexture;
+        mutable SDL_FPoint batchTextureSize;
+        void AppendQuad(const DrawCommand& command, const Camera* camera) const;
+        void FlushBatch() const;
+        void Submit(const DrawCommand& command, const Camera* camera) const;
+        static SDL_FRect GetBounds(const DrawCommand& command);
+        static uint64_t GetSortKey(const DrawCommand& command, unsigned int sequence);
+        static const char* GetLayerName(unsigned int layer);
+    public:
+        DrawList();
+        void Clear();
+        void SetLayer(unsigned int layer);
+        void Add(SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& worldRectangle, SDL_RendererFlip flip, float angle = 0.0f, SDL_FPoint pivot = {0.5f, 0.5f});
+        void AddScreen(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& screenRectangle, SDL_RendererFlip flip);
+        void AddGeometry(SDL_Texture* texture, const std::vector<SDL_Vertex>& vertices, const std::vector<int>& indices);
+        SDL_Vertex* AddWorldQuads(SDL_Texture* texture, unsigned int quadCount, const SDL_FRect& bounds);
+        unsigned int GetCount() const;
+        void Sort();
+        void Cull(const std::vector<Camera>& cameras);
+        void Draw() const;
+        void DrawScreen() const;
+};
+
+#endif
@@ -3,10 +3,18 @@
 
 Entity::Entity(EntityManager& manager): manager(manager) {
     isActive = true;
+    isStatic = false;
 }
 
 Entity::Entity(EntityManager& manager, std::string name, constants::LayerType layer): manager(manager), name(name), layer(layer) {
     isActive = true;
+    isStatic = false;
+}
+
+Entity::~Entity() {
+    for (auto& component: components) {
+        delete component;
+    }
 }
 
 void Entity::Update(float deltaTime) {
@@ -29,6 +37,24 @@ bool Entity::IsActive() const {
     return isActive;
 }
 
+bool Entity::IsStatic() const {
+    return isStatic;
+}
+
+void Entity::SetStatic(bool isStatic) {
+    this->isStatic = isStatic;
+    manager.InvalidateBatches();
+}
+
+// the manager caches component lists per batch, so a new component has to be picked up on the next rebuild
+void Entity::InvalidateBatches() {
+    manager.InvalidateBatches();
+}
+
+const std::vector<Component*>& Entity::GetComponents() const {
+    return components;
+}
+
 void Entity::ListAllComponents() const {
     for (auto mapElement : componentTypeMap) {
         std::cout << "Component<" << mapElement.first->name() << ">" << std::endl;
@@ -14,18 +14,24 @@ class Entity {
     private:
         EntityManager& manager;
         bool isActive;
+        bool isStatic;
         std::vector<Component*> components;
         std::map<const std::type_info*, Component*> componentTypeMap;
+        void InvalidateBatches();
     public:
         std::string name;
         constants::LayerType layer;
         Entity(EntityManager& manager);
         Entity(EntityManager& manager, std::string name, constants::LayerType layer);
+        ~Entity();
         void Update(float deltaTime);
         void Render();
         void Destroy();
         bool IsActive() const;
+        bool IsStatic() const;
+        void SetStatic(bool isStatic);
         void ListAllComponents() const;
+        const std::vector<Component*>& GetComponents() const;
 
         template <typename T, typename... TArgs>
         T& AddComponent(TArgs&&... args) {
@@ -34,6 +40,7 @@ class Entity {
             newComponent->owner = this;
             components.emplace_back(newComponent);
             componentTypeMap[&typeid(*newComponent)] = newComponent;
+            InvalidateBatches();
             newComponent->Initialize();
             return *newComponent;
         }
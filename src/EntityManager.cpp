@@ -1,6 +1,18 @@
+#include <algorithm>
+#include <cxxabi.h>
+#include <cstdlib>
+#include <map>
 #include "./EntityManager.h"
 #include "./Collision.h"
+#include "./Kinematics.h"
+#include "./Metrics.h"
+#include "./Profiler.h"
 #include "./Components/ColliderComponent.h"
+#include "./Components/TransformComponent.h"
+#include "./Components/ProjectileEmitterComponent.h"
+#include "./Components/SpriteComponent.h"
+#include "./Components/AnimatorComponent.h"
+#include "./Components/SoundComponent.h"
 
 void EntityManager::ClearData() {
     for (auto& entity: entities  ) {
@@ -13,23 +25,256 @@ bool EntityManager::HasNoEntities() {
 }
 
 void EntityManager::Update(float deltaTime) {
-    for (auto& entity: entities) {
+    IntegrateTransforms(deltaTime);
+    UpdateProjectiles();
+    for (auto& entity: dynamicEntities) {
         entity->Update(deltaTime);
     }
+    AdvanceAnimations(deltaTime);
     DestroyInactiveEntities();
 }
 
+void EntityManager::RebuildBatches() {
+    // static entities never move, so they are left out of integration and component updates altogether,
+    // except sound emitters whose pan and distance follow the camera even when they stand still
+    dynamicEntities.clear();
+    for (auto& layer: layerEntities) {
+        layer.clear();
+    }
+    for (auto& entity: entities) {
+        if (!entity->IsStatic() || entity->HasComponent<SoundComponent>()) {
+            dynamicEntities.emplace_back(entity);
+        }
+        layerEntities[entity->layer].emplace_back(entity);
+    }
+
+    // components that reach into shared systems are kept out of the parallel update
+    parallelComponents.clear();
+    serialComponents.clear();
+    for (auto& entity: dynamicEntities) {
+        for (auto& component: entity->GetComponents()) {
+            if (component->IsParallelSafe()) {
+                parallelComponents.emplace_back(component);
+            } else {
+                serialComponents.emplace_back(component);
+            }
+        }
+    }
+
+    // static sprites still animate, so every animated sprite is batched regardless of the static flag
+    animatedSprites.clear();
+    for (auto& entity: entities) {
+        if (entity->HasComponent<SpriteComponent>() && entity->GetComponent<SpriteComponent>()->IsAnimated()) {
+            animatedSprites.emplace_back(entity->GetComponent<SpriteComponent>());
+        }
+    }
+    animationElapsed.resize(animatedSprites.size());
+    animationFrame.resize(animatedSprites.size());
+    frameDuration.resize(animatedSprites.size());
+    frameCount.resize(animatedSprites.size());
+
+    animators.clear();
+    for (auto& entity: entities) {
+        if (entity->HasComponent<AnimatorComponent>() && entity->GetComponent<AnimatorComponent>()->IsReady()) {
+            animators.emplace_back(entity->GetComponent<AnimatorComponent>());
+        }
+    }
+    animatorGraphs.resize(animators.size());
+    animatorClip.resize(animators.size());
+    animatorFrame.resize(animators.size());
+    animatorElapsed.resize(animators.size());
+    animatorFinished.resize(animators.size());
+    animatorChanged.resize(animators.size());
+    animatorVelocityX.resize(animators.size());
+    animatorVelocityY.resize(animators.size());
+    animatorActions.resize(animators.size());
+    for (unsigned int i = 0; i < animators.size(); i++) {
+        animatorGraphs[i] = animators[i]->GetGraph();
+    }
+
+    // projectiles are packed first so their positions share indices with the transform arrays
+    transforms.clear();
+    projectiles.clear();
+    for (auto& entity: dynamicEntities) {
+        if (entity->HasComponent<TransformComponent>() && entity->HasComponent<ProjectileEmitterComponent>()) {
+            transforms.emplace_back(entity->GetComponent<TransformComponent>());
+            projectiles.emplace_back(entity->GetComponent<ProjectileEmitterComponent>());
+        }
+    }
+    for (auto& entity: dynamicEntities) {
+        if (entity->HasComponent<TransformComponent>() && !entity->HasComponent<ProjectileEmitterComponent>()) {
+            transforms.emplace_back(entity->GetComponent<TransformComponent>());
+        }
+    }
+
+    positionX.resize(transforms.size());
+    positionY.resize(transforms.size());
+    velocityX.resize(transforms.size());
+    velocityY.resize(transforms.size());
+
+    originX.resize(projectiles.size());
+    originY.resize(projectiles.size());
+    rangeSquared.resize(projectiles.size());
+    isOutOfRange.resize(projectiles.size());
+    for (unsigned int i = 0; i < projectiles.size(); i++) {
+        originX[i] = projectiles[i]->GetOrigin().x;
+        originY[i] = projectiles[i]->GetOrigin().y;
+        rangeSquared[i] = static_cast<float>(projectiles[i]->GetRange()) * projectiles[i]->GetRange();
+    }
+    isBatchDirty = false;
+}
+
+void EntityManager::IntegrateTransforms(float deltaTime) {
+    if (isBatchDirty) {
+        RebuildBatches();
+    }
+    unsigned int count = transforms.size();
+    for (unsigned int i = 0; i < count; i++) {
+        transforms[i]->previousPosition = transforms[i]->position;
+        positionX[i] = transforms[i]->position.x;
+        positionY[i] = transforms[i]->position.y;
+        velocityX[i] = transforms[i]->velocity.x;
+        velocityY[i] = transforms[i]->velocity.y;
+    }
+    Kinematics::Integrate(positionX.data(), positionY.data(), velocityX.data(), velocityY.data(), count, deltaTime);
+    for (unsigned int i = 0; i < count; i++) {
+        if (transforms[i]->position.x != positionX[i] || transforms[i]->position.y != positionY[i]) {
+            transforms[i]->position.x = positionX[i];
+            transforms[i]->position.y = positionY[i];
+            transforms[i]->version++;
+        }
+    }
+}
+
+void EntityManager::UpdateProjectiles() {
+    if (isBatchDirty) {
+        RebuildBatches();
+    }
+    unsigned int count = projectiles.size();
+    Kinematics::FindOutOfRange(
+        positionX.data(),
+        positionY.data(),
+        originX.data(),
+        originY.data(),
+        rangeSquared.data(),
+        isOutOfRange.data(),
+        count
+    );
+    for (unsigned int i = 0; i < count; i++) {
+        if (isOutOfRange[i]) {
+            projectiles[i]->OnOutOfRange();
+        }
+    }
+}
+
+void EntityManager::AdvanceAnimations(float deltaTime) {
+    if (isBatchDirty) {
+        RebuildBatches();
+    }
+    unsigned int count = animatedSprites.size();
+    for (unsigned int i = 0; i < count; i++) {
+        const Animation& animation = animatedSprites[i]->GetCurrentAnimation();
+        animationElapsed[i] = animatedSprites[i]->animationElapsed;
+        animationFrame[i] = animatedSprites[i]->animationFrame;
+        frameDuration[i] = animation.frameDuration;
+        frameCount[i] = animation.numFrames;
+    }
+    Animation::Advance(animationElapsed.data(), animationFrame.data(), frameDuration.data(), frameCount.data(), count, deltaTime);
+    for (unsigned int i = 0; i < count; i++) {
+        animatedSprites[i]->animationElapsed = animationElapsed[i];
+        if (animatedSprites[i]->animationFrame != animationFrame[i]) {
+            animatedSprites[i]->SetFrame(animationFrame[i]);
+        }
+    }
+
+    // input only feeds the animators of player controlled entities
+    unsigned int heldActions = 0;
+    for (unsigned int action = 0; action < constants::NUM_ACTIONS; action++) {
+        if (Game::inputManager->IsActionDown(static_cast<constants::ActionType>(action))) {
+            heldActions |= 1u << action;
+        }
+    }
+    count = animators.size();
+    for (unsigned int i = 0; i < count; i++) {
+        animatorClip[i] = animators[i]->clip;
+        animatorFrame[i] = animators[i]->frame;
+        animatorElapsed[i] = animators[i]->elapsed;
+        animatorFinished[i] = animators[i]->isFinished;
+        animatorVelocityX[i] = animators[i]->GetVelocity().x;
+        animatorVelocityY[i] = animators[i]->GetVelocity().y;
+        animatorActions[i] = animators[i]->HasInput() ? heldActions : 0;
+    }
+    animationEvents.clear();
+    AnimationGraph::Evaluate(
+        animatorGraphs.data(),
+        animatorClip.data(),
+        animatorFrame.data(),
+        animatorElapsed.data(),
+        animatorFinished.data(),
+        animatorChanged.data(),
+        animatorVelocityX.data(),
+        animatorVelocityY.data(),
+        animatorActions.data(),
+        count,
+        deltaTime,
+        animationEvents
+    );
+    for (unsigned int i = 0; i < count; i++) {
+        animators[i]->elapsed = animatorElapsed[i];
+        animators[i]->isFinished = animatorFinished[i];
+        if (animatorChanged[i]) {
+            animators[i]->clip = animatorClip[i];
+            animators[i]->frame = animatorFrame[i];
+            animators[i]->ApplyFrame();
+        }
+    }
+    for (auto& animationEvent: animationEvents) {
+        animators[animationEvent.animator]->OnEvent(animationEvent.event);
+    }
+}
+
+void EntityManager::UpdateComponents(float deltaTime, JobSystem& jobSystem) {
+    if (isBatchDirty) {
+        RebuildBatches();
+    }
+    jobSystem.ParallelFor("components", parallelComponents.size(), 64, [this, deltaTime](unsigned int begin, unsigned int end) {
+        for (unsigned int i = begin; i < end; i++) {
+            parallelComponents[i]->Update(deltaTime);
+        }
+    });
+}
+
+void EntityManager::UpdateSerialComponents(float deltaTime) {
+    if (isBatchDirty) {
+        RebuildBatches();
+    }
+    for (auto& component: serialComponents) {
+        component->Update(deltaTime);
+    }
+}
+
+void EntityManager::InvalidateBatches() {
+    isBatchDirty = true;
+}
+
 void EntityManager::DestroyInactiveEntities() {
-    for (int i = 0; i < entities.size(); i++) {
-        if (!entities[i]->IsActive()) {
-            entities.erase(entities.begin() + i);
+    // a partition keeps the inactive pointers in the tail so they can be freed, remove_if would overwrite them
+    auto firstInactive = std::stable_partition(entities.begin(), entities.end(), [](Entity* entity) {
+        return entity->IsActive();
+    });
+    if (firstInactive != entities.end()) {
+        for (auto entity = firstInactive; entity != entities.end(); entity++) {
+            delete *entity;
         }
+        entities.erase(firstInactive, entities.end());
+        isBatchDirty = true;
     }
 }
 
 void EntityManager::Render() {
     for (int layerNumber = 0; layerNumber < constants::NUM_LAYERS; layerNumber++) {
-        for (auto &entity: GetEntitiesByLayer(static_cast<constants::LayerType>(layerNumber))) {
+        Game::drawList->SetLayer(layerNumber);
+        for (auto &entity: GetLayerEntities(static_cast<constants::LayerType>(layerNumber))) {
             entity->Render();
         }
     }
@@ -45,6 +290,14 @@ std::vector<Entity*> EntityManager::GetEntitiesByLayer(constants::LayerType laye
     return selectedEntities;
 }
 
+// layer lists are kept with the batches, so per-frame walks over one layer skip every other entity
+const std::vector<Entity*>& EntityManager::GetLayerEntities(constants::LayerType layer) {
+    if (isBatchDirty) {
+        RebuildBatches();
+    }
+    return layerEntities[layer];
+}
+
 Entity* EntityManager::GetEntityByName(std::string entityName) const {
     for (auto* entity: entities) {
         if (entity->name.compare(entityName) == 0) {
@@ -54,34 +307,48 @@ Entity* EntityManager::GetEntityByName(std::string entityName) const {
     return NULL;
 }
 
+constants::CollisionType EntityManager::GetCollisionType(const std::string& thisTag, const std::string& thatTag) {
+    if (thisTag.compare("PLAYER") == 0 && thatTag.compare("ENEMY") == 0) {
+        return constants::PLAYER_ENEMY_COLLISION;
+    }
+    if (thisTag.compare("PLAYER") == 0 && thatTag.compare("PROJECTILE") == 0) {
+        return constants::PLAYER_PROJECTILE_COLLISION;
+    }
+    if (thisTag.compare("ENEMY") == 0 && thatTag.compare("FRIENDLY_PROJECTILE") == 0) {
+        return constants::ENEMY_PROJECTILE_COLLISION;
+    }
+    if (thisTag.compare("PLAYER") == 0 && thatTag.compare("LEVEL_COMPLETE") == 0) {
+        return constants::PLAYER_LEVEL_COMPLETE_COLLISION;
+    }
+    return constants::NO_COLLISION;
+}
+
 constants::CollisionType EntityManager::CheckCollisions() const {
-    for (int i = 0; i < entities.size() - 1; i++) {
+    constants::CollisionType collisionType = constants::NO_COLLISION;
+    unsigned int pairsTested = 0;
+    unsigned int hits = 0;
+    for (int i = 0; i + 1 < entities.size() && collisionType == constants::NO_COLLISION; i++) {
         auto& thisEntity = entities[i];
         if (thisEntity->HasComponent<ColliderComponent>()) {
             ColliderComponent* thisCollider = thisEntity->GetComponent<ColliderComponent>();
-            for (int j = i + 1; j < entities.size(); j++) {
+            for (int j = i + 1; j < entities.size() && collisionType == constants::NO_COLLISION; j++) {
                 auto& thatEntity = entities[j];
                 if (thisEntity->name.compare(thatEntity->name) != 0 && thatEntity->HasComponent<ColliderComponent>()) {
                     ColliderComponent* thatCollider = thatEntity->GetComponent<ColliderComponent>();
+                    pairsTested++;
                     if (Collision::CheckRectangleCollision(thisCollider->collider, thatCollider->collider)) {
-                        if (thisCollider->colliderTag.compare("PLAYER") == 0 && thatCollider->colliderTag.compare("ENEMY") == 0) {
-                            return constants::PLAYER_ENEMY_COLLISION;
-                        }
-                        if (thisCollider->colliderTag.compare("PLAYER") == 0 && thatCollider->colliderTag.compare("PROJECTILE") == 0) {
-                            return constants::PLAYER_PROJECTILE_COLLISION;
-                        }
-                        if (thisCollider->colliderTag.compare("ENEMY") == 0 && thatCollider->colliderTag.compare("FRIENDLY_PROJECTILE") == 0) {
-                            return constants::ENEMY_PROJECTILE_COLLISION;
-                        }
-                        if (thisCollider->colliderTag.compare("PLAYER") == 0 && thatCollider->colliderTag.compare("LEVEL_COMPLETE") == 0) {
-                            return constants::PLAYER_LEVEL_COMPLETE_COLLISION;
-                        }
+                        hits++;
+                        collisionType = GetCollisionType(thisCollider->colliderTag, thatCollider->colliderTag);
                     }
                 }
             }
         }
     }
-    return constants::NO_COLLISION;
+    static const unsigned int collisionPairs = Metrics::Register("collision pairs", METRIC_COUNTER);
+    static const unsigned int collisionHits = Metrics::Register("collision hits", METRIC_COUNTER);
+    Metrics::Add(collisionPairs, pairsTested);
+    Metrics::Add(collisionHits, hits);
+    return collisionType;
 }
 
 // retired method
@@ -104,6 +371,7 @@ std::string EntityManager::CheckEntityCollisions(Entity &myEntity) const {
 Entity& EntityManager::AddEntity(std::string entityName, constants::LayerType layer) {
     Entity* newEntity = new Entity(*this, entityName, layer);
     entities.emplace_back(newEntity);
+    isBatchDirty = true;
     return *newEntity;
 }
 
@@ -113,4 +381,49 @@ std::vector<Entity*> EntityManager::GetEntities() const {
 
 unsigned int EntityManager::GetEntityCount() {
     return entities.size();
+}
+
+void EntityManager::UpdateMetrics() const {
+    static unsigned int entityMetric = Metrics::Register("entities", METRIC_GAUGE);
+    static unsigned int layerMetrics[constants::NUM_LAYERS];
+    static std::map<const std::type_info*, unsigned int> componentMetrics;
+    static bool isRegistered = false;
+    if (!isRegistered) {
+        for (unsigned int layer = 0; layer < constants::NUM_LAYERS; layer++) {
+            layerMetrics[layer] = Metrics::Register(std::string("entities/") + constants::LAYER_NAMES[layer], METRIC_GAUGE);
+        }
+        isRegistered = true;
+    }
+
+    unsigned int layerCounts[constants::NUM_LAYERS] = {};
+    std::map<const std::type_info*, unsigned int> componentCounts;
+    for (auto& entity: entities) {
+        layerCounts[entity->layer]++;
+        for (auto& component: entity->GetComponents()) {
+            componentCounts[&typeid(*component)]++;
+        }
+    }
+
+    Metrics::Set(entityMetric, entities.size());
+    for (unsigned int layer = 0; layer < constants::NUM_LAYERS; layer++) {
+        Metrics::Set(layerMetrics[layer], layerCounts[layer]);
+    }
+    for (auto& componentCount: componentCounts) {
+        auto metric = componentMetrics.find(componentCount.first);
+        if (metric == componentMetrics.end()) {
+            // component types are registered the first time they are seen, under their demangled class name
+            int status = 0;
+            char* typeName = abi::__cxa_demangle(componentCount.first->name(), NULL, NULL, &status);
+            std::string name = std::string("components/") + (status == 0 ? typeName : componentCount.first->name());
+            std::free(typeName);
+            metric = componentMetrics.emplace(componentCount.first, Metrics::Register(name, METRIC_GAUGE)).first;
+        }
+        Metrics::Set(metric->second, componentCount.second);
+    }
+    // types with no live components left still report zero
+    for (auto& metric: componentMetrics) {
+        if (componentCounts.count(metric.first) == 0) {
+            Metrics::Set(metric.second, 0);
+        }
+    }
 }
\ No newline at end of file
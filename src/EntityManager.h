@@ -4,20 +4,69 @@
 #include "./Entity.h"
 #include "./Component.h"
 #include "./Constants.h"
+#include "./JobSystem.h"
+#include "./AnimationGraph.h"
+
+class TransformComponent;
+class ProjectileEmitterComponent;
+class SpriteComponent;
+class AnimatorComponent;
+class AnimationGraph;
 
 class EntityManager {
     private:
         std::vector<Entity*> entities;
+        std::vector<Entity*> dynamicEntities;
+        std::vector<Component*> parallelComponents;
+        std::vector<Component*> serialComponents;
+        std::vector<Entity*> layerEntities[constants::NUM_LAYERS];
+        bool isBatchDirty = true;
+        std::vector<TransformComponent*> transforms;
+        std::vector<ProjectileEmitterComponent*> projectiles;
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> originX;
+        std::vector<float> originY;
+        std::vector<float> rangeSquared;
+        std::vector<unsigned char> isOutOfRange;
+        std::vector<SpriteComponent*> animatedSprites;
+        std::vector<float> animationElapsed;
+        std::vector<unsigned int> animationFrame;
+        std::vector<float> frameDuration;
+        std::vector<unsigned int> frameCount;
+        std::vector<AnimatorComponent*> animators;
+        std::vector<const AnimationGraph*> animatorGraphs;
+        std::vector<unsigned int> animatorClip;
+        std::vector<unsigned int> animatorFrame;
+        std::vector<float> animatorElapsed;
+        std::vector<unsigned char> animatorFinished;
+        std::vector<unsigned char> animatorChanged;
+        std::vector<float> animatorVelocityX;
+        std::vector<float> animatorVelocityY;
+        std::vector<unsigned int> animatorActions;
+        std::vector<AnimationEvent> animationEvents;
+        void RebuildBatches();
+        static constants::CollisionType GetCollisionType(const std::string& thisTag, const std::string& thatTag);
     public:
         void ClearData();
         void Update(float deltaTime);
+        void IntegrateTransforms(float deltaTime);
+        void UpdateProjectiles();
+        void AdvanceAnimations(float deltaTime);
+        void UpdateComponents(float deltaTime, JobSystem& jobSystem);
+        void UpdateSerialComponents(float deltaTime);
+        void InvalidateBatches();
         void Render();
         bool HasNoEntities();
         Entity& AddEntity(std::string entityName, constants::LayerType layer);
         std::vector<Entity*> GetEntities() const;
         std::vector<Entity*> GetEntitiesByLayer(constants::LayerType layer) const;
+        const std::vector<Entity*>& GetLayerEntities(constants::LayerType layer);
         Entity* GetEntityByName(std::string entityName) const;
         unsigned int GetEntityCount();
+        void UpdateMetrics() const;
         std::string CheckEntityCollisions(Entity& entity) const; // retired method
         constants::CollisionType CheckCollisions() const;
         void DestroyInactiveEntities();
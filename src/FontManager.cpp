@@ -1,9 +1,19 @@
 #include "./FontManager.h"
+#include "./TextureManager.h"
 
 TTF_Font* FontManager::LoadFont(const char* fileName, int fontSize) {
     return TTF_OpenFont(fileName, fontSize);
 }
 
+// the font reads its face straight from the caller's buffer, which must outlive it
+TTF_Font* FontManager::LoadFont(const std::vector<char>& fileData, int fontSize) {
+    if (fileData.empty()) {
+        return NULL;
+    }
+    return TTF_OpenFontRW(SDL_RWFromConstMem(fileData.data(), static_cast<int>(fileData.size())), 1, fontSize);
+}
+
 void FontManager::Draw(SDL_Texture *texture, SDL_Rect position) {
     SDL_RenderCopy(Game::renderer, texture, NULL, &position);
+    TextureManager::CountDrawCall(texture);
 }
\ No newline at end of file
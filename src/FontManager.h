@@ -1,11 +1,13 @@
 #ifndef FONTMANAGER_H
 #define FONTMANAGER_H
 
+#include <vector>
 #include "./Game.h"
 
 class FontManager {
     public:
         static TTF_Font* LoadFont(const char* fileName, int fontSize);  
+        static TTF_Font* LoadFont(const std::vector<char>& fileData, int fontSize);
         static void Draw(SDL_Texture* texture, SDL_Rect position);
 };
 
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include "./FramePacer.h"
+
+FramePacer::FramePacer() {
+    frequency = SDL_GetPerformanceFrequency();
+    targetFrameTime = 1.0 / constants::FPS;
+    Reset();
+}
+
+void FramePacer::Reset() {
+    lastFrameCounter = SDL_GetPerformanceCounter();
+    frameTimeCount = 0;
+    frameTimeIndex = 0;
+    stutterCount = 0;
+}
+
+void FramePacer::SetTargetFrameRate(unsigned int framesPerSecond) {
+    targetFrameTime = framesPerSecond > 0 ? 1.0 / framesPerSecond : 0.0;
+}
+
+double FramePacer::GetSecondsSince(Uint64 counter) const {
+    return static_cast<double>(SDL_GetPerformanceCounter() - counter) / frequency;
+}
+
+double FramePacer::WaitForNextFrame(bool shouldWait) {
+    if (shouldWait && targetFrameTime > 0.0) {
+        // SDL_Delay only has millisecond granularity and may oversleep,
+        // so sleep for the bulk of the wait and spin through the last stretch
+        double remaining = targetFrameTime - GetSecondsSince(lastFrameCounter);
+        if (remaining > constants::FRAME_SPIN_THRESHOLD) {
+            SDL_Delay(static_cast<Uint32>((remaining - constants::FRAME_SPIN_THRESHOLD) * 1000.0));
+        }
+        while (GetSecondsSince(lastFrameCounter) < targetFrameTime) {
+        }
+    }
+    Uint64 now = SDL_GetPerformanceCounter();
+    double frameTime = static_cast<double>(now - lastFrameCounter) / frequency;
+    lastFrameCounter = now;
+    RecordFrameTime(frameTime);
+    return frameTime;
+}
+
+void FramePacer::RecordFrameTime(double frameTime) {
+    double expectedFrameTime = targetFrameTime > 0.0 ? targetFrameTime : GetMeanFrameTime();
+    if (frameTimeCount > 0 && frameTime > expectedFrameTime * constants::STUTTER_FACTOR) {
+        stutterCount++;
+    }
+    frameTimes[frameTimeIndex] = frameTime;
+    frameTimeIndex = (frameTimeIndex + 1) % constants::FRAME_HISTORY_SIZE;
+    frameTimeCount = std::min(frameTimeCount + 1, constants::FRAME_HISTORY_SIZE);
+}
+
+double FramePacer::GetMeanFrameTime() const {
+    if (frameTimeCount == 0) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (unsigned int i = 0; i < frameTimeCount; i++) {
+        total += frameTimes[i];
+    }
+    return total / frameTimeCount;
+}
+
+double FramePacer::GetPercentileFrameTime(double percentile) const {
+    if (frameTimeCount == 0) {
+        return 0.0;
+    }
+    std::copy(frameTimes, frameTimes + frameTimeCount, sortedFrameTimes);
+    unsigned int rank = static_cast<unsigned int>(percentile * (frameTimeCount - 1));
+    std::nth_element(sortedFrameTimes, sortedFrameTimes + rank, sortedFrameTimes + frameTimeCount);
+    return sortedFrameTimes[rank];
+}
+
+unsigned int FramePacer::GetStutterCount() const {
+    return stutterCount;
+}
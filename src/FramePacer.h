@@ -0,0 +1,29 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL2/SDL.h>
+#include "./Constants.h"
+
+class FramePacer {
+    private:
+        Uint64 frequency;
+        Uint64 lastFrameCounter;
+        double targetFrameTime;
+        double frameTimes[constants::FRAME_HISTORY_SIZE];
+        mutable double sortedFrameTimes[constants::FRAME_HISTORY_SIZE];
+        unsigned int frameTimeCount;
+        unsigned int frameTimeIndex;
+        unsigned int stutterCount;
+        double GetSecondsSince(Uint64 counter) const;
+        void RecordFrameTime(double frameTime);
+    public:
+        FramePacer();
+        void Reset();
+        void SetTargetFrameRate(unsigned int framesPerSecond);
+        double WaitForNextFrame(bool shouldWait);
+        double GetMeanFrameTime() const;
+        double GetPercentileFrameTime(double percentile) const;
+        unsigned int GetStutterCount() const;
+};
+
+#endif
@@ -1,27 +1,56 @@
 #include <iostream>
+#include <ctime>
 #include "./Constants.h"
 #include "Game.h"
 #include "./AssetManager.h"
 #include "./Map.h"
+#include "./Metrics.h"
+#include "./Profiler.h"
 #include "./Components/TransformComponent.h"
 #include "./Components/SpriteComponent.h"
 #include "./Components/KeyboardControlComponent.h"
 #include "./Components/ColliderComponent.h"
 #include "./Components/TextLabelComponent.h"
 #include "./Components/ProjectileEmitterComponent.h"
+#include "./Components/SoundComponent.h"
+#include "./Components/MinimapComponent.h"
+#include "./Components/AnimatorComponent.h"
+#include "./Components/ParticleEmitterComponent.h"
 #include "../lib/glm/glm.hpp"
 
 EntityManager manager;
 AssetManager* Game::assetManager = new AssetManager(&manager);
 SDL_Renderer* Game::renderer;
-SDL_Event Game::event;
-SDL_Rect Game::camera = {0, 0, constants::WINDOW_WIDTH, constants::WINDOW_HEIGHT};
+InputManager* Game::inputManager = new InputManager();
+AudioManager* Game::audioManager = new AudioManager();
+ParticleSystem* Game::particleSystem = new ParticleSystem();
+std::vector<Camera> Game::cameras(1);
+DrawList* Game::drawList = NULL;
+float Game::interpolationAlpha = 1.0f;
 Entity* mainPlayer = NULL;
 Map* map;
+#ifdef ENABLE_PROFILER
+ProfilerOverlay* profilerOverlay = NULL;
+#endif
 
 
 Game::Game() {
     isRunning = false;
+    isHeadless = false;
+    window = NULL;
+    tickLimit = 0;
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    frameMode = constants::FRAME_CAPPED;
+    SetTickRate(constants::TICK_RATE);
+    tickCount = 0;
+    seed = static_cast<unsigned int>(std::time(NULL));
+    accumulator = 0.0f;
+    frameTime = 0.0f;
+    recordIndex = 0;
+    isSimulationPending = false;
+    isSimulationStopping = false;
+    drawList = &drawLists[recordIndex];
 }
 
 Game::~Game() {}
@@ -30,8 +59,57 @@ bool Game::IsRunning() const {
     return isRunning;
 }
 
+void Game::SetWorkerCount(unsigned int workerCount) {
+    this->workerCount = workerCount;
+}
+
+void Game::SetTickRate(unsigned int tickRate) {
+    this->tickRate = tickRate;
+    deltaTime = 1.0f / tickRate;
+}
+
+void Game::SetFrameMode(constants::FrameMode frameMode) {
+    this->frameMode = frameMode;
+}
+
+void Game::SetHeadless(bool isHeadless) {
+    this->isHeadless = isHeadless;
+}
+
+void Game::SetTickLimit(unsigned int tickLimit) {
+    this->tickLimit = tickLimit;
+}
+
+void Game::SetRecordFile(std::string filePath) {
+    recordFilePath = filePath;
+}
+
+void Game::SetReplayFile(std::string filePath) {
+    replayFilePath = filePath;
+}
+
+void Game::SetTraceFile(std::string filePath) {
+    traceFilePath = filePath;
+}
+
+void Game::SetMetricsFile(std::string filePath) {
+    metricsFilePath = filePath;
+}
+
+std::vector<JobTiming> Game::GetJobTimings() const {
+    return jobSystem.GetTimings();
+}
+
+const FramePacer& Game::GetFramePacer() const {
+    return framePacer;
+}
+
 void Game::Initialize(int width, int height) {
-    if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
+    if (isHeadless) {
+        // the dummy driver lets the event and timer subsystems run without a display
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    }
+    if (SDL_Init(isHeadless ? (SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_EVENTS) : SDL_INIT_EVERYTHING) != 0) {
         std::cerr << "Error initializing SDL." << std::endl;
         return;
     }
@@ -39,35 +117,98 @@ void Game::Initialize(int width, int height) {
         std::cerr << "Error initializing TTF." << std::endl;
         return;        
     }
-    window = SDL_CreateWindow(
-        NULL,
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        width,
-        height,
-        SDL_WINDOW_BORDERLESS
-    );
-    if(!window) {
-        std::cerr << "Error creating SDL window." << std::endl;
-        return;
+    if (!isHeadless) {
+        window = SDL_CreateWindow(
+            NULL,
+            SDL_WINDOWPOS_CENTERED,
+            SDL_WINDOWPOS_CENTERED,
+            width,
+            height,
+            SDL_WINDOW_BORDERLESS
+        );
+        if(!window) {
+            std::cerr << "Error creating SDL window." << std::endl;
+            return;
+        }
+        renderer = SDL_CreateRenderer(window, -1, frameMode == constants::FRAME_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0);
+        if(!renderer) {
+            std::cerr << "Error creating SDL renderer." << std::endl;
+            return;
+        }
+        // stutters are judged against the frame interval the mode actually paces to, uncapped frames
+        // against their running mean and vsync against the display's refresh rate when it is known
+        if (frameMode == constants::FRAME_UNCAPPED) {
+            framePacer.SetTargetFrameRate(0);
+        } else if (frameMode == constants::FRAME_VSYNC) {
+            SDL_DisplayMode displayMode;
+            bool hasRefreshRate = SDL_GetWindowDisplayMode(window, &displayMode) == 0 && displayMode.refresh_rate > 0;
+            framePacer.SetTargetFrameRate(hasRefreshRate ? displayMode.refresh_rate : 0);
+        }
+        // the game keeps running silently when no audio device is available
+        audioManager->Initialize();
+        particleSystem->Initialize();
+#ifdef ENABLE_PROFILER
+        profilerOverlay = new ProfilerOverlay();
+#endif
     }
-    renderer = SDL_CreateRenderer(window, -1, 0);
-    if(!renderer) {
-        std::cerr << "Error creating SDL renderer." << std::endl;
-        return;
+    // a replay restores the seed and tick rate it was recorded with before the level is built
+    if (!replayFilePath.empty()) {
+        if (!replayPlayer.Open(replayFilePath)) {
+            return;
+        }
+        seed = replayPlayer.GetHeader().seed;
+        SetTickRate(replayPlayer.GetHeader().tickRate);
     }
+    std::srand(seed);
+
     LoadLevel(1);
 
+    if (!recordFilePath.empty() && !replayRecorder.Open(recordFilePath, seed, tickRate, 1)) {
+        return;
+    }
+
+    jobSystem.Initialize(workerCount);
+    BuildUpdateGraph();
+
+    if (!metricsFilePath.empty()) {
+        Metrics::OpenCsv(metricsFilePath);
+    }
+    if (!traceFilePath.empty()) {
+#ifdef ENABLE_PROFILER
+        Profiler::StartCapture(traceFilePath);
+#else
+        std::cerr << "Trace capture requires a profiler build (make profile)" << std::endl;
+#endif
+    }
+
+    framePacer.Reset();
+    simulationStartCounter = SDL_GetPerformanceCounter();
     isRunning = true;
+    // SDL wants the window's renderer and events on the main thread, so simulation and command recording
+    // move to their own thread instead and the main thread stays the render thread
+    if (!isHeadless && replayFilePath.empty()) {
+        // frame 0 is recorded here so the first present already shows the level
+        RecordFrame();
+        recordIndex = 1 - recordIndex;
+        simulationThread = std::thread(&Game::SimulationLoop, this);
+    }
     return;
 }
 
 void Game::LoadLevel(int levelNumber) {
+    std::string levelName = "Level" + std::to_string(levelNumber);
+    LoadLevelScript("./assets/scripts/" + levelName + ".lua", levelName);
+}
+
+void Game::LoadLevelScript(std::string scriptPath, std::string levelName) {
+    // covers the whole load, script execution as well as texture decoding, the map and entity construction
+    static const unsigned int levelLoadTime = Metrics::Register("level load ms", METRIC_COUNTER);
+    Uint64 loadStart = SDL_GetPerformanceCounter();
+    particleSystem->Clear();
     sol::state lua;
     lua.open_libraries(sol::lib::base, sol::lib::os, sol::lib::math);
-
-    std::string levelName = "Level" + std::to_string(levelNumber);
-    lua.script_file("./assets/scripts/" + levelName + ".lua");
+    lua.script("math.randomseed(" + std::to_string(seed) + ")");
+    lua.script_file(scriptPath);
 
     sol::table levelData = lua[levelName];
     sol::table levelAssets = levelData["assets"];   
@@ -84,11 +225,44 @@ void Game::LoadLevel(int levelNumber) {
                 std::string assetId = asset["id"];
                 std::string assetFile = asset["file"];
                 assetManager->AddTexture(assetId, assetFile.c_str());
-            } 
+            } else if (assetType.compare("sound") == 0) {
+                std::string assetId = asset["id"];
+                std::string assetFile = asset["file"];
+                int priority = asset["priority"].get_or(constants::DEFAULT_SOUND_PRIORITY);
+                unsigned int maxVoices = asset["maxVoices"].get_or(constants::DEFAULT_SOUND_VOICES);
+                assetManager->AddSound(assetId, assetFile.c_str(), priority, maxVoices);
+            } else if (assetType.compare("font") == 0) {
+                std::string assetId = asset["id"];
+                std::string assetFile = asset["file"];
+                bool isScalable = asset["scalable"].get_or(false);
+                assetManager->AddFont(assetId, assetFile.c_str(), static_cast<int>(asset["fontSize"]), isScalable);
+            } else if (assetType.compare("animation") == 0) {
+                std::string assetId = asset["id"];
+                AnimationGraph* graph = LoadAnimationGraph(asset);
+                if (graph) {
+                    assetManager->AddAnimationGraph(assetId, graph);
+                }
+            } else if (assetType.compare("particles") == 0) {
+                std::string assetId = asset["id"];
+                assetManager->AddParticleEmitter(assetId, LoadParticleEmitter(asset));
+            }
         }
         assetIndex++;
     }
 
+    // music is streamed by the audio thread, the level only queues the track
+    sol::optional<sol::table> existsLevelMusic = levelData["music"];
+    if (existsLevelMusic != sol::nullopt) {
+        std::string musicFile = levelData["music"]["file"];
+        audioManager->PlayMusic(
+            musicFile,
+            levelData["music"]["fadeMs"].get_or(constants::MUSIC_FADE_MS),
+            levelData["music"]["loop"].get_or(true)
+        );
+    } else {
+        audioManager->StopMusic(constants::MUSIC_FADE_MS);
+    }
+
     /*********************************************/
     /* LOADS MAP FROM LUA CONFIG FILE            */
     /*********************************************/
@@ -136,8 +310,16 @@ void Game::LoadLevel(int levelNumber) {
                     static_cast<int>(entity["components"]["transform"]["velocity"]["y"]),
                     static_cast<int>(entity["components"]["transform"]["width"]),
                     static_cast<int>(entity["components"]["transform"]["height"]),
-                    static_cast<int>(entity["components"]["transform"]["scale"])
+                    entity["components"]["transform"]["scale"].get_or(1.0f),
+                    entity["components"]["transform"]["rotation"].get_or(0.0f)
                 );
+                sol::optional<sol::table> existsPivot = entity["components"]["transform"]["pivot"];
+                if (existsPivot != sol::nullopt) {
+                    newEntity.GetComponent<TransformComponent>()->pivot = glm::vec2(
+                        entity["components"]["transform"]["pivot"]["x"].get_or(0.5f),
+                        entity["components"]["transform"]["pivot"]["y"].get_or(0.5f)
+                    );
+                }
             }
 
             // Add sprite component
@@ -163,13 +345,69 @@ void Game::LoadLevel(int levelNumber) {
             if (existsInputComponent != sol::nullopt) {
                 sol::optional<sol::table> existsKeyboardInputComponent = entity["components"]["input"]["keyboard"];
                 if (existsKeyboardInputComponent != sol::nullopt) {
-                    std::string upKey = entity["components"]["input"]["keyboard"]["up"];
-                    std::string rightKey = entity["components"]["input"]["keyboard"]["right"];
-                    std::string downKey = entity["components"]["input"]["keyboard"]["down"];
-                    std::string leftKey = entity["components"]["input"]["keyboard"]["left"];
-                    std::string shootKey = entity["components"]["input"]["keyboard"]["shoot"];
-                    newEntity.AddComponent<KeyboardControlComponent>(upKey, rightKey, downKey, leftKey, shootKey);
+                    for (unsigned int action = 0; action < constants::NUM_ACTIONS; action++) {
+                        sol::optional<std::string> keyName = entity["components"]["input"]["keyboard"][constants::ACTION_NAMES[action]];
+                        if (keyName != sol::nullopt) {
+                            inputManager->BindKey(
+                                static_cast<constants::ActionType>(action),
+                                SDL_GetScancodeFromKey(SDL_GetKeyFromName(keyName->c_str()))
+                            );
+                        }
+                    }
                 }
+                sol::optional<sol::table> existsGamepadInputComponent = entity["components"]["input"]["gamepad"];
+                if (existsGamepadInputComponent != sol::nullopt) {
+                    for (unsigned int action = 0; action < constants::NUM_ACTIONS; action++) {
+                        sol::optional<std::string> buttonName = entity["components"]["input"]["gamepad"][constants::ACTION_NAMES[action]];
+                        if (buttonName != sol::nullopt) {
+                            inputManager->BindControllerButton(
+                                static_cast<constants::ActionType>(action),
+                                SDL_GameControllerGetButtonFromString(buttonName->c_str())
+                            );
+                        }
+                    }
+                }
+                newEntity.AddComponent<KeyboardControlComponent>();
+            }
+
+            // Add sound component
+            sol::optional<sol::table> existsSoundComponent = entity["components"]["sound"];
+            if (existsSoundComponent != sol::nullopt) {
+                std::string soundAssetId = entity["components"]["sound"]["soundAssetId"];
+                bool isLooping = entity["components"]["sound"]["loop"].get_or(false);
+                newEntity.AddComponent<SoundComponent>(soundAssetId, isLooping);
+            }
+
+            // Add animator component
+            sol::optional<sol::table> existsAnimatorComponent = entity["components"]["animator"];
+            if (existsAnimatorComponent != sol::nullopt) {
+                std::string animationAssetId = entity["components"]["animator"]["animationAssetId"];
+                newEntity.AddComponent<AnimatorComponent>(animationAssetId);
+            }
+
+            // Add particle emitter component
+            sol::optional<sol::table> existsParticlesComponent = entity["components"]["particles"];
+            if (existsParticlesComponent != sol::nullopt && newEntity.HasComponent<TransformComponent>()) {
+                std::string particleAssetId = entity["components"]["particles"]["particleAssetId"];
+                glm::vec2 offset(
+                    entity["components"]["particles"]["offset"]["x"].get_or(0.0f),
+                    entity["components"]["particles"]["offset"]["y"].get_or(0.0f)
+                );
+                newEntity.AddComponent<ParticleEmitterComponent>(particleAssetId, offset);
+            }
+
+            // Add minimap component
+            sol::optional<sol::table> existsMinimapComponent = entity["components"]["minimap"];
+            if (existsMinimapComponent != sol::nullopt && newEntity.HasComponent<TransformComponent>()) {
+                unsigned int layerMask = constants::MINIMAP_DEFAULT_LAYERS;
+                sol::optional<sol::table> existsMinimapLayers = entity["components"]["minimap"]["layers"];
+                if (existsMinimapLayers != sol::nullopt) {
+                    layerMask = 0;
+                    for (auto &layer: *existsMinimapLayers) {
+                        layerMask |= 1u << layer.second.as<unsigned int>();
+                    }
+                }
+                newEntity.AddComponent<MinimapComponent>(map, layerMask);
             }
 
             // Add collider component
@@ -224,73 +462,381 @@ void Game::LoadLevel(int levelNumber) {
                     projectileHeight
                 );
             }
+
+            // entities that never move are flagged static unless the script says otherwise
+            sol::optional<bool> isStatic = entity["static"];
+            if (isStatic != sol::nullopt) {
+                newEntity.SetStatic(*isStatic);
+            } else {
+                bool isMoving = newEntity.HasComponent<TransformComponent>() &&
+                    newEntity.GetComponent<TransformComponent>()->velocity != glm::vec2(0.0f, 0.0f);
+                newEntity.SetStatic(!isMoving && existsInputComponent == sol::nullopt && existsParticlesComponent == sol::nullopt);
+            }
         }
         entityIndex++;
     }
 
     mainPlayer = manager.GetEntityByName("player");    
+    LoadCameras(levelData);
+    Metrics::Add(levelLoadTime, static_cast<double>(SDL_GetPerformanceCounter() - loadStart) * 1000.0 / SDL_GetPerformanceFrequency());
 }
 
 void Game::ProcessInput() {
-    SDL_PollEvent(&event);
-    switch(event.type) {
-        case SDL_QUIT: {
-            isRunning = false;
-            break;
-        }
-        case SDL_KEYDOWN: {
-            if (event.key.keysym.sym == SDLK_ESCAPE ) {
-                isRunning = false;
-            }
-        } 
-        default: {
-            break;
+    PROFILE_ZONE("input");
+    inputManager->ProcessEvents();
+    if (inputManager->IsQuitRequested() || inputManager->WasKeyPressed(SDL_SCANCODE_ESCAPE)) {
+        isRunning = false;
+    }
+    // F3 dumps the last frame's metrics to the console
+    if (inputManager->WasKeyPressedThisFrame(SDL_SCANCODE_F3)) {
+        Metrics::Print(std::cout);
+    }
+#ifdef ENABLE_PROFILER
+    if (profilerOverlay && inputManager->WasKeyPressedThisFrame(SDL_SCANCODE_F1)) {
+        profilerOverlay->Toggle();
+    }
+    // F2 starts and stops a capture named after the wall clock time
+    if (inputManager->WasKeyPressedThisFrame(SDL_SCANCODE_F2)) {
+        if (Profiler::IsCapturing()) {
+            Profiler::StopCapture();
+        } else {
+            Profiler::StartCapture("trace-" + std::to_string(std::time(NULL)) + ".json");
         }
-    }  
+    }
+#endif
 }
 
 void Game::Update() {
+    manager.UpdateMetrics();
+    if (isHeadless || !replayFilePath.empty()) {
+        UpdateUnpaced();
+        return;
+    }
+
+    frameTime = framePacer.WaitForNextFrame(frameMode == constants::FRAME_CAPPED);
+    frameTime = (frameTime > constants::MAX_FRAME_TIME) ? constants::MAX_FRAME_TIME : frameTime;
 
-    int timeToWait = constants::FRAME_TARGET_TIME - (SDL_GetTicks() - ticksLastFrame);
-    if (timeToWait > 0 && timeToWait <= constants::FRAME_TARGET_TIME) {
-        SDL_Delay(timeToWait);
+    // the simulation thread ticks and records frame N+1 while Render draws and presents frame N
+    {
+        std::lock_guard<std::mutex> lock(simulationMutex);
+        isSimulationPending = true;
     }
-    float deltaTime = (SDL_GetTicks() - ticksLastFrame) / 1000.0f;
-    deltaTime = (deltaTime > 0.05f) ? 0.05 : deltaTime;
+    simulationCondition.notify_all();
+}
 
-    ticksLastFrame = SDL_GetTicks();
+// the simulation thread ticks inputManager, which the main thread fills in ProcessInput, and reads the
+// cameras and frameTime written in Update. That is only safe because the main loop orders every frame as
+// ProcessInput, Update (signal), Render (draw, then WaitForSimulation), so no main-thread input or state
+// change can overlap a running Simulate. Anything added to the main loop after Update and before the wait
+// must not touch simulation state
+void Game::SimulationLoop() {
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    while (true) {
+        simulationCondition.wait(lock, [this]() { return isSimulationPending || isSimulationStopping; });
+        if (isSimulationStopping) {
+            return;
+        }
+        lock.unlock();
+        Simulate();
+        lock.lock();
+        isSimulationPending = false;
+        simulationCondition.notify_all();
+    }
+}
 
-    //todo: here we call manager update
-    manager.Update(deltaTime);
+void Game::WaitForSimulation() {
+    PROFILE_ZONE("wait simulation");
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    simulationCondition.wait(lock, [this]() { return !isSimulationPending; });
+}
 
-    HandleCameraMovement();
+void Game::Simulate() {
+    // the simulation always advances in fixed steps, rendering interpolates between the last two
+    {
+        PROFILE_ZONE("update");
+        accumulator += frameTime;
+        jobSystem.BeginFrame();
+        while (accumulator >= deltaTime && isRunning) {
+            if (replayRecorder.IsOpen()) {
+                replayRecorder.Record(inputManager->GetActionSnapshot());
+            }
+            Tick();
+            inputManager->EndTick();
+            accumulator -= deltaTime;
+        }
+        interpolationAlpha = accumulator / deltaTime;
+        RecordJobTimings();
+    }
+    RecordFrame();
+}
 
-    CheckCollisions();
+// components write into the back list, which is then sorted and culled for every camera so the render
+// thread only has to replay it
+void Game::RecordFrame() {
+    PROFILE_ZONE("record");
+    drawList = &drawLists[recordIndex];
+    drawList->Clear();
+    if (!manager.HasNoEntities()) {
+        HandleCameraMovement();
+        manager.Render();
+        particleSystem->Render();
+    }
+    drawList->Sort();
+    drawList->Cull(cameras);
+}
+
+void Game::UpdateUnpaced() {
+    // headless runs and replays advance one tick per loop with no pacing so identical workloads finish as fast as possible
+    if (replayPlayer.IsOpen()) {
+        ActionSnapshot snapshot;
+        if (!replayPlayer.NextTick(snapshot)) {
+            isRunning = false;
+            return;
+        }
+        inputManager->SetActionSnapshot(snapshot);
+    }
+    if (replayRecorder.IsOpen()) {
+        replayRecorder.Record(inputManager->GetActionSnapshot());
+    }
+    jobSystem.BeginFrame();
+    Tick();
+    inputManager->EndTick();
+    RecordJobTimings();
+    interpolationAlpha = 1.0f;
+    if (tickLimit > 0 && tickCount >= tickLimit) {
+        isRunning = false;
+    }
+}
+
+void Game::Tick() {
+    updateGraph.Run(jobSystem);
+    tickCount++;
+}
+
+// the time spent inside jobs this frame, summed over every worker, is recorded whether or not the profiler is built in
+void Game::RecordJobTimings() {
+    static const unsigned int jobTime = Metrics::Register("job ms", METRIC_COUNTER);
+    double total = 0.0;
+    for (auto& timing: jobSystem.GetTimings()) {
+        total += timing.durationMs;
+    }
+    Metrics::Add(jobTime, total);
+}
+
+void Game::BuildUpdateGraph() {
+    unsigned int movement = updateGraph.AddSystem("movement", [this]() {
+        manager.IntegrateTransforms(deltaTime);
+    });
+    unsigned int projectiles = updateGraph.AddSystem("projectiles", [this]() {
+        manager.UpdateProjectiles();
+    });
+    unsigned int components = updateGraph.AddSystem("components", [this]() {
+        manager.UpdateComponents(deltaTime, jobSystem);
+    });
+    unsigned int sharedComponents = updateGraph.AddSystem("shared components", [this]() {
+        manager.UpdateSerialComponents(deltaTime);
+    });
+    unsigned int animation = updateGraph.AddSystem("animation", [this]() {
+        manager.AdvanceAnimations(deltaTime);
+    });
+    unsigned int particles = updateGraph.AddSystem("particles", [this]() {
+        particleSystem->Update(deltaTime);
+    });
+    unsigned int cleanup = updateGraph.AddSystem("cleanup", [this]() {
+        // inactive entities are freed here, so nothing may keep pointing at them
+        for (auto &camera: cameras) {
+            if (camera.target && !camera.target->IsActive()) {
+                camera.target = NULL;
+            }
+        }
+        if (mainPlayer && !mainPlayer->IsActive()) {
+            mainPlayer = NULL;
+        }
+        manager.DestroyInactiveEntities();
+    });
+    unsigned int collision = updateGraph.AddSystem("collision", [this]() {
+        CheckCollisions();
+    });
+    updateGraph.AddDependency(movement, projectiles);
+    updateGraph.AddDependency(projectiles, components);
+    updateGraph.AddDependency(components, sharedComponents);
+    updateGraph.AddDependency(sharedComponents, animation);
+    updateGraph.AddDependency(animation, cleanup);
+    updateGraph.AddDependency(sharedComponents, particles);
+    updateGraph.AddDependency(cleanup, collision);
 }
 
 void Game::Render() {
-    SDL_SetRenderDrawColor(renderer, 21, 21, 21, 255);
-    SDL_RenderClear(renderer);
-    
-    //todo: we call manager render to render all entities
-    if (manager.HasNoEntities()) {
+    if (isHeadless || !replayFilePath.empty()) {
         return;
     }
-    manager.Render();
+    {
+        PROFILE_ZONE("render");
+        SDL_SetRenderDrawColor(renderer, 21, 21, 21, 255);
+        SDL_RenderClear(renderer);
+
+        // the front list was recorded during the previous frame, or by Initialize for the first one
+        const DrawList& frame = drawLists[1 - recordIndex];
+        {
+            PROFILE_ZONE("camera");
+            frame.Draw();
+        }
+        frame.DrawScreen();
+
+#ifdef ENABLE_PROFILER
+        profilerOverlay->Render();
+#endif
+
+        PROFILE_ZONE("present");
+        SDL_RenderPresent(renderer);
+    }
+    WaitForSimulation();
+    recordIndex = 1 - recordIndex;
+}
 
-    SDL_RenderPresent(renderer);
+// clips list their frames as cells of a sheet with their own durations, a frame event names a sound asset
+// to play when the frame is entered, transitions move between clips on velocity, input or a clip finishing
+AnimationGraph* Game::LoadAnimationGraph(sol::table asset) {
+    AnimationGraph* graph = new AnimationGraph();
+    int frameWidth = asset["frameWidth"];
+    int frameHeight = asset["frameHeight"];
+    unsigned int clipIndex = 0;
+    while (true) {
+        sol::optional<sol::table> existsClipIndexNode = asset["clips"][clipIndex];
+        if (existsClipIndexNode == sol::nullopt) {
+            break;
+        }
+        sol::table clip = asset["clips"][clipIndex];
+        std::string clipName = clip["name"];
+        graph->AddClip(clipName, clip["loop"].get_or(true));
+        unsigned int frameIndex = 0;
+        while (true) {
+            sol::optional<sol::table> existsFrameIndexNode = clip["frames"][frameIndex];
+            if (existsFrameIndexNode == sol::nullopt) {
+                break;
+            }
+            sol::table frame = clip["frames"][frameIndex];
+            SDL_Rect source = {
+                frame["column"].get_or(0) * frameWidth,
+                frame["row"].get_or(0) * frameHeight,
+                frameWidth,
+                frameHeight
+            };
+            sol::optional<std::string> event = frame["event"];
+            graph->AddFrame(source, frame["duration"].get_or(0.1f), event != sol::nullopt ? assetManager->GetSound(*event) : constants::NO_SOUND);
+            frameIndex++;
+        }
+        clipIndex++;
+    }
+    unsigned int transitionIndex = 0;
+    while (true) {
+        sol::optional<sol::table> existsTransitionIndexNode = asset["transitions"][transitionIndex];
+        if (existsTransitionIndexNode == sol::nullopt) {
+            break;
+        }
+        sol::table transition = asset["transitions"][transitionIndex];
+        graph->AddTransition(transition["from"].get_or(std::string("*")), transition["to"], transition["when"].get_or(std::string("always")));
+        transitionIndex++;
+    }
+    if (!graph->Compile()) {
+        std::string assetId = asset["id"];
+        std::cerr << "Error compiling animation " << assetId << std::endl;
+        delete graph;
+        return NULL;
+    }
+    return graph;
 }
 
-void Game::HandleCameraMovement() {
-    if (mainPlayer) {
-        TransformComponent* mainPlayerTransform = mainPlayer->GetComponent<TransformComponent>();
-        camera.x = mainPlayerTransform->position.x - (constants::WINDOW_WIDTH / 2);
-        camera.y = mainPlayerTransform->position.y - (constants::WINDOW_HEIGHT / 2);
+// rates are particles per second, angles are degrees with 0 pointing right, colours fade from start to end
+ParticleEmitterDefinition Game::LoadParticleEmitter(sol::table asset) {
+    ParticleEmitterDefinition definition;
+    definition.rate = asset["rate"].get_or(0.0f);
+    definition.burst = asset["burst"].get_or(0u);
+    definition.lifetime = asset["lifetime"].get_or(1.0f);
+    definition.lifetimeVariance = asset["lifetimeVariance"].get_or(0.0f);
+    definition.speed = asset["speed"].get_or(0.0f);
+    definition.speedVariance = asset["speedVariance"].get_or(0.0f);
+    definition.direction = asset["direction"].get_or(0.0f);
+    definition.spread = asset["spread"].get_or(360.0f);
+    definition.gravity = glm::vec2(asset["gravity"]["x"].get_or(0.0f), asset["gravity"]["y"].get_or(0.0f));
+    definition.startSize = asset["startSize"].get_or(4.0f);
+    definition.endSize = asset["endSize"].get_or(definition.startSize);
+    definition.startColor = {
+        asset["startColor"]["r"].get_or(static_cast<Uint8>(255)),
+        asset["startColor"]["g"].get_or(static_cast<Uint8>(255)),
+        asset["startColor"]["b"].get_or(static_cast<Uint8>(255)),
+        asset["startColor"]["a"].get_or(static_cast<Uint8>(255))
+    };
+    definition.endColor = {
+        asset["endColor"]["r"].get_or(definition.startColor.r),
+        asset["endColor"]["g"].get_or(definition.startColor.g),
+        asset["endColor"]["b"].get_or(definition.startColor.b),
+        asset["endColor"]["a"].get_or(static_cast<Uint8>(0))
+    };
+    return definition;
+}
 
-        camera.x = camera.x < 0 ? 0 : camera.x;
-        camera.y = camera.y < 0 ? 0 : camera.y;
-        camera.x = camera.x > camera.w ? camera.w : camera.x;
-        camera.y = camera.y > camera.h ? camera.h : camera.y;
+// levels without a cameras table get a single full-window view following the player
+void Game::LoadCameras(sol::table levelData) {
+    cameras.clear();
+    sol::optional<sol::table> existsCameras = levelData["cameras"];
+    if (existsCameras == sol::nullopt) {
+        cameras.emplace_back();
+        cameras.back().target = mainPlayer;
+    } else {
+        unsigned int cameraIndex = 0;
+        while (true) {
+            sol::optional<sol::table> existsCameraIndexNode = levelData["cameras"][cameraIndex];
+            if (existsCameraIndexNode == sol::nullopt) {
+                break;
+            }
+            sol::table view = levelData["cameras"][cameraIndex];
+            SDL_Rect viewport = {
+                view["viewport"]["x"].get_or(0),
+                view["viewport"]["y"].get_or(0),
+                view["viewport"]["width"].get_or(static_cast<int>(constants::WINDOW_WIDTH)),
+                view["viewport"]["height"].get_or(static_cast<int>(constants::WINDOW_HEIGHT))
+            };
+            Camera camera(viewport, view["zoom"].get_or(1.0f));
+            sol::optional<std::string> followName = view["follow"];
+            if (followName != sol::nullopt) {
+                camera.target = manager.GetEntityByName(*followName);
+                if (camera.target && !camera.target->HasComponent<TransformComponent>()) {
+                    camera.target = NULL;
+                }
+                if (!camera.target) {
+                    std::cerr << "Camera " << cameraIndex << " follows unknown entity " << *followName << std::endl;
+                }
+            }
+            sol::optional<sol::table> existsLayers = view["layers"];
+            if (existsLayers != sol::nullopt) {
+                camera.layerMask = 0;
+                for (auto &layer: *existsLayers) {
+                    camera.layerMask |= 1u << layer.second.as<unsigned int>();
+                }
+            }
+            cameras.push_back(camera);
+            cameraIndex++;
+        }
+        if (cameras.empty()) {
+            cameras.emplace_back();
+        }
+    }
+    for (auto &camera: cameras) {
+        if (camera.target) {
+            camera.CenterOn(camera.target->GetComponent<TransformComponent>()->position);
+        }
+        camera.ClampTo(map->GetBounds());
+    }
+}
+
+void Game::HandleCameraMovement() {
+    for (auto &camera: cameras) {
+        if (camera.target && camera.target->IsActive()) {
+            glm::vec2 targetPosition = camera.target->GetComponent<TransformComponent>()->GetInterpolatedPosition(interpolationAlpha);
+            camera.Follow(targetPosition, frameTime);
+            camera.ClampTo(map->GetBounds());
+        }
     }
 }
 
@@ -318,7 +864,36 @@ void Game::ProcessNextLevel(int levelNumber) {
 }
 
 void Game::Destroy() {
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
+    if (isHeadless || !replayFilePath.empty()) {
+        double elapsed = static_cast<double>(SDL_GetPerformanceCounter() - simulationStartCounter) / SDL_GetPerformanceFrequency();
+        std::cout << "Simulated " << tickCount << " ticks in " << elapsed << " s ("
+            << tickCount / elapsed << " ticks/s)" << std::endl;
+    } else {
+        std::cout << "Frame time: mean " << framePacer.GetMeanFrameTime() * 1000.0 << " ms, p99 "
+            << framePacer.GetPercentileFrameTime(0.99) * 1000.0 << " ms, "
+            << framePacer.GetStutterCount() << " stutters" << std::endl;
+    }
+    if (simulationThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(simulationMutex);
+            isSimulationStopping = true;
+        }
+        simulationCondition.notify_all();
+        simulationThread.join();
+    }
+    jobSystem.Shutdown();
+    replayRecorder.Close();
+    audioManager->Destroy();
+    Metrics::CloseCsv();
+#ifdef ENABLE_PROFILER
+    Profiler::StopCapture();
+    delete profilerOverlay;
+#endif
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+    }
     SDL_Quit();
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
@@ -8,29 +12,92 @@
 #include "./Entity.h"
 #include "./Component.h"
 #include "./EntityManager.h"
+#include "./JobSystem.h"
+#include "./Constants.h"
+#include "./FramePacer.h"
+#include "./InputManager.h"
+#include "./Replay.h"
+#include "./AudioManager.h"
+#include "./Camera.h"
+#include "./DrawList.h"
+#include "./ParticleSystem.h"
 
 class AssetManager;
+class AnimationGraph;
 
 class Game {
     private:
-        bool isRunning;
+        std::atomic<bool> isRunning;
+        bool isHeadless;
         SDL_Window *window;
-        
+        unsigned int workerCount;
+        constants::FrameMode frameMode;
+        unsigned int tickRate;
+        unsigned int tickCount;
+        unsigned int tickLimit;
+        unsigned int seed;
+        float deltaTime;
+        float accumulator;
+        float frameTime;
+        FramePacer framePacer;
+        std::string recordFilePath;
+        std::string replayFilePath;
+        std::string traceFilePath;
+        std::string metricsFilePath;
+        ReplayRecorder replayRecorder;
+        ReplayPlayer replayPlayer;
+        Uint64 simulationStartCounter;
+        void UpdateUnpaced();
+        JobSystem jobSystem;
+        SystemGraph updateGraph;
+        void BuildUpdateGraph();
+        void Tick();
+        void RecordJobTimings();
+        DrawList drawLists[2];
+        unsigned int recordIndex;
+        std::thread simulationThread;
+        std::mutex simulationMutex;
+        std::condition_variable simulationCondition;
+        bool isSimulationPending;
+        bool isSimulationStopping;
+        void SimulationLoop();
+        void Simulate();
+        void RecordFrame();
+        void WaitForSimulation();
+
     public:
         Game();
         ~Game();
-        int ticksLastFrame;
         bool IsRunning() const;
+        void SetWorkerCount(unsigned int workerCount);
+        void SetTickRate(unsigned int tickRate);
+        void SetFrameMode(constants::FrameMode frameMode);
+        void SetHeadless(bool isHeadless);
+        void SetTickLimit(unsigned int tickLimit);
+        void SetRecordFile(std::string filePath);
+        void SetReplayFile(std::string filePath);
+        void SetTraceFile(std::string filePath);
+        void SetMetricsFile(std::string filePath);
+        std::vector<JobTiming> GetJobTimings() const;
+        const FramePacer& GetFramePacer() const;
         static SDL_Renderer *renderer;
         static AssetManager*  assetManager;
-        static SDL_Event event;
-        static SDL_Rect camera;
+        static InputManager* inputManager;
+        static AudioManager* audioManager;
+        static ParticleSystem* particleSystem;
+        static std::vector<Camera> cameras;
+        static DrawList* drawList;
+        static float interpolationAlpha;
         void LoadLevel(int levelNumber);
+        void LoadLevelScript(std::string scriptPath, std::string levelName);
         void Initialize(int width, int height);
         void ProcessInput();
         void Update();
         void Render();
         void Destroy();
+        void LoadCameras(sol::table levelData);
+        AnimationGraph* LoadAnimationGraph(sol::table asset);
+        ParticleEmitterDefinition LoadParticleEmitter(sol::table asset);
         void HandleCameraMovement();
         void CheckCollisions();
         void ProcessGameOver();
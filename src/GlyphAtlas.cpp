@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <iostream>
+#include "./GlyphAtlas.h"
+#include "./Game.h"
+#include "./TextureManager.h"
+
+GlyphAtlas::GlyphAtlas(TTF_Font* font, bool isScalable): font(font) {
+    texture = NULL;
+    lineHeight = 0;
+    shelfX = 0;
+    shelfY = 0;
+    shelfHeight = 0;
+    for (unsigned int i = 0; i < constants::GLYPH_COUNT; i++) {
+        glyphs[i] = {false, {0, 0, 0, 0}, 0};
+    }
+    if (!font || !Game::renderer) {
+        return;
+    }
+    lineHeight = TTF_FontHeight(font);
+    texture = SDL_CreateTexture(
+        Game::renderer,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_STATIC,
+        constants::GLYPH_ATLAS_SIZE,
+        constants::GLYPH_ATLAS_SIZE
+    );
+    if (!texture) {
+        std::cerr << "Error creating glyph atlas: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    // scalable atlases are rasterised once at a large size and filtered down to whatever size a label asks for
+    if (isScalable) {
+        SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+    }
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void GlyphAtlas::AddGlyph(Uint16 character) {
+    glyphs[character].isLoaded = true;
+    if (character < constants::FIRST_GLYPH || !texture) {
+        return;
+    }
+    int minX, maxX, minY, maxY, advance;
+    if (TTF_GlyphMetrics(font, character, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+        return;
+    }
+    glyphs[character].advance = advance;
+    SDL_Surface* rendered = TTF_RenderGlyph_Blended(font, character, constants::WHITE_COLOR);
+    if (!rendered) {
+        return;
+    }
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(rendered);
+    if (!surface) {
+        return;
+    }
+    // glyphs are packed left to right on shelves as tall as the tallest glyph in the row
+    if (shelfX + surface->w > constants::GLYPH_ATLAS_SIZE) {
+        shelfX = 0;
+        shelfY += shelfHeight + 1;
+        shelfHeight = 0;
+    }
+    if (shelfY + surface->h > constants::GLYPH_ATLAS_SIZE) {
+        std::cerr << "Glyph atlas is full" << std::endl;
+        SDL_FreeSurface(surface);
+        return;
+    }
+    SDL_Rect source = {shelfX, shelfY, surface->w, surface->h};
+    SDL_UpdateTexture(texture, &source, surface->pixels, surface->pitch);
+    glyphs[character].source = source;
+    shelfX += surface->w + 1;
+    shelfHeight = std::max(shelfHeight, surface->h);
+    SDL_FreeSurface(surface);
+}
+
+SDL_Texture* GlyphAtlas::GetTexture() const {
+    return texture;
+}
+
+int GlyphAtlas::GetLineHeight() const {
+    return lineHeight;
+}
+
+SDL_Rect GlyphAtlas::Layout(const std::string& text, int x, int y, float scale, const SDL_Color& color, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) {
+    // the output vectors are cleared but keep their capacity, so relaying a string no longer than before never allocates
+    vertices.clear();
+    indices.clear();
+    float penX = static_cast<float>(x);
+    const float atlasSize = static_cast<float>(constants::GLYPH_ATLAS_SIZE);
+    for (unsigned char character: text) {
+        if (!glyphs[character].isLoaded) {
+            AddGlyph(character);
+        }
+        const Glyph& glyph = glyphs[character];
+        if (glyph.source.w > 0) {
+            const SDL_Rect& source = glyph.source;
+            float left = penX;
+            float top = static_cast<float>(y);
+            float right = left + source.w * scale;
+            float bottom = top + source.h * scale;
+            float u0 = source.x / atlasSize;
+            float v0 = source.y / atlasSize;
+            float u1 = (source.x + source.w) / atlasSize;
+            float v1 = (source.y + source.h) / atlasSize;
+            int first = static_cast<int>(vertices.size());
+            vertices.push_back({{left, top}, color, {u0, v0}});
+            vertices.push_back({{right, top}, color, {u1, v0}});
+            vertices.push_back({{right, bottom}, color, {u1, v1}});
+            vertices.push_back({{left, bottom}, color, {u0, v1}});
+            indices.push_back(first);
+            indices.push_back(first + 1);
+            indices.push_back(first + 2);
+            indices.push_back(first);
+            indices.push_back(first + 2);
+            indices.push_back(first + 3);
+        }
+        penX += glyph.advance * scale;
+    }
+    return {x, y, static_cast<int>(penX) - x, static_cast<int>(lineHeight * scale)};
+}
+
+void GlyphAtlas::Draw(const std::vector<SDL_Vertex>& vertices, const std::vector<int>& indices) const {
+    if (!texture || indices.empty()) {
+        return;
+    }
+    Game::drawList->AddGeometry(texture, vertices, indices);
+}
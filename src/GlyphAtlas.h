@@ -0,0 +1,37 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "./Constants.h"
+
+struct Glyph {
+    bool isLoaded;
+    SDL_Rect source;
+    int advance;
+};
+
+// each latin-1 glyph of one font is rasterised into a single white texture the first time a string uses it,
+// strings are laid out as textured quads and tinted through the vertex colour
+class GlyphAtlas {
+    private:
+        TTF_Font* font;
+        SDL_Texture* texture;
+        Glyph glyphs[constants::GLYPH_COUNT];
+        int lineHeight;
+        int shelfX;
+        int shelfY;
+        int shelfHeight;
+        void AddGlyph(Uint16 character);
+    public:
+        GlyphAtlas(TTF_Font* font, bool isScalable);
+        ~GlyphAtlas();
+        SDL_Texture* GetTexture() const;
+        int GetLineHeight() const;
+        SDL_Rect Layout(const std::string& text, int x, int y, float scale, const SDL_Color& color, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices);
+        void Draw(const std::vector<SDL_Vertex>& vertices, const std::vector<int>& indices) const;
+};
+
+#endif
@@ -0,0 +1,210 @@
+#include "./InputManager.h"
+
+InputManager::InputManager() {
+    buttonState = 0;
+    previousButtonState = 0;
+    eventStart = 0;
+    eventCount = 0;
+    isQuitRequested = false;
+    actionState = 0;
+    actionPressed = 0;
+    actionReleased = 0;
+    ClearBindings();
+}
+
+InputManager::~InputManager() {
+    for (auto& controller: controllers) {
+        SDL_GameControllerClose(controller);
+    }
+}
+
+void InputManager::ClearBindings() {
+    for (auto& action: keyActions) {
+        action = constants::NO_ACTION;
+    }
+    for (auto& action: buttonActions) {
+        action = constants::NO_ACTION;
+    }
+    for (auto& holdCount: actionHoldCount) {
+        holdCount = 0;
+    }
+    actionState = 0;
+}
+
+void InputManager::BindKey(constants::ActionType action, SDL_Scancode scancode) {
+    if (scancode > SDL_SCANCODE_UNKNOWN && scancode < SDL_NUM_SCANCODES) {
+        keyActions[scancode] = action;
+    }
+}
+
+void InputManager::BindControllerButton(constants::ActionType action, SDL_GameControllerButton button) {
+    if (button > SDL_CONTROLLER_BUTTON_INVALID && button < SDL_CONTROLLER_BUTTON_MAX) {
+        buttonActions[button] = action;
+    }
+}
+
+void InputManager::SetAction(unsigned char action, bool isDown) {
+    // an action stays down while any key or button bound to it is held
+    if (action == constants::NO_ACTION) {
+        return;
+    }
+    Uint32 mask = 1u << action;
+    if (isDown) {
+        if (actionHoldCount[action]++ == 0) {
+            actionState |= mask;
+            actionPressed |= mask;
+        }
+    } else if (actionHoldCount[action] > 0) {
+        if (--actionHoldCount[action] == 0) {
+            actionState &= ~mask;
+            actionReleased |= mask;
+        }
+    }
+}
+
+void InputManager::ProcessEvents() {
+    framePressedKeys.reset();
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        switch (event.type) {
+            case SDL_QUIT: {
+                isQuitRequested = true;
+                break;
+            }
+            case SDL_KEYDOWN:
+            case SDL_KEYUP: {
+                if (event.key.repeat) {
+                    break;
+                }
+                keyState[event.key.keysym.scancode] = event.type == SDL_KEYDOWN;
+                if (event.type == SDL_KEYDOWN) {
+                    framePressedKeys[event.key.keysym.scancode] = true;
+                }
+                SetAction(keyActions[event.key.keysym.scancode], event.type == SDL_KEYDOWN);
+                PushEvent({event.type, event.key.keysym.sym, event.key.keysym.scancode, 0});
+                break;
+            }
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP: {
+                Uint32 mask = 1u << event.button.button;
+                buttonState = event.type == SDL_MOUSEBUTTONDOWN ? (buttonState | mask) : (buttonState & ~mask);
+                PushEvent({event.type, SDLK_UNKNOWN, SDL_SCANCODE_UNKNOWN, event.button.button});
+                break;
+            }
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP: {
+                if (event.cbutton.button < SDL_CONTROLLER_BUTTON_MAX) {
+                    SetAction(buttonActions[event.cbutton.button], event.type == SDL_CONTROLLERBUTTONDOWN);
+                }
+                break;
+            }
+            case SDL_CONTROLLERDEVICEADDED: {
+                SDL_GameController* controller = SDL_GameControllerOpen(event.cdevice.which);
+                if (controller) {
+                    controllers.emplace_back(controller);
+                }
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+}
+
+void InputManager::PushEvent(const InputEvent& inputEvent) {
+    // when a burst overflows the ring the oldest edges are dropped, the state bits stay exact
+    if (eventCount == constants::INPUT_EVENT_CAPACITY) {
+        eventStart = (eventStart + 1) % constants::INPUT_EVENT_CAPACITY;
+        eventCount--;
+    }
+    events[(eventStart + eventCount) % constants::INPUT_EVENT_CAPACITY] = inputEvent;
+    eventCount++;
+}
+
+void InputManager::EndTick() {
+    previousKeyState = keyState;
+    previousButtonState = buttonState;
+    actionPressed = 0;
+    actionReleased = 0;
+    eventStart = 0;
+    eventCount = 0;
+}
+
+bool InputManager::IsKeyDown(SDL_Scancode scancode) const {
+    return keyState[scancode];
+}
+
+bool InputManager::WasKeyPressed(SDL_Scancode scancode) const {
+    for (unsigned int i = 0; i < eventCount; i++) {
+        const InputEvent& inputEvent = GetEvent(i);
+        if (inputEvent.type == SDL_KEYDOWN && inputEvent.scancode == scancode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InputManager::WasKeyReleased(SDL_Scancode scancode) const {
+    for (unsigned int i = 0; i < eventCount; i++) {
+        const InputEvent& inputEvent = GetEvent(i);
+        if (inputEvent.type == SDL_KEYUP && inputEvent.scancode == scancode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// the event ring lives until the next tick, so a frame without a tick would see the same press again,
+// debug hotkeys read this edge instead, which only covers the events polled this frame
+bool InputManager::WasKeyPressedThisFrame(SDL_Scancode scancode) const {
+    return framePressedKeys[scancode];
+}
+
+bool InputManager::IsButtonDown(Uint8 button) const {
+    return buttonState & (1u << button);
+}
+
+bool InputManager::WasButtonPressed(Uint8 button) const {
+    for (unsigned int i = 0; i < eventCount; i++) {
+        const InputEvent& inputEvent = GetEvent(i);
+        if (inputEvent.type == SDL_MOUSEBUTTONDOWN && inputEvent.button == button) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InputManager::IsActionDown(constants::ActionType action) const {
+    return actionState & (1u << action);
+}
+
+bool InputManager::WasActionPressed(constants::ActionType action) const {
+    return actionPressed & (1u << action);
+}
+
+bool InputManager::WasActionReleased(constants::ActionType action) const {
+    return actionReleased & (1u << action);
+}
+
+ActionSnapshot InputManager::GetActionSnapshot() const {
+    return {actionState, actionPressed, actionReleased};
+}
+
+void InputManager::SetActionSnapshot(const ActionSnapshot& snapshot) {
+    actionState = snapshot.state;
+    actionPressed = snapshot.pressed;
+    actionReleased = snapshot.released;
+}
+
+bool InputManager::IsQuitRequested() const {
+    return isQuitRequested;
+}
+
+unsigned int InputManager::GetEventCount() const {
+    return eventCount;
+}
+
+const InputEvent& InputManager::GetEvent(unsigned int index) const {
+    return events[(eventStart + index) % constants::INPUT_EVENT_CAPACITY];
+}
@@ -0,0 +1,66 @@
+#ifndef INPUTMANAGER_H
+#define INPUTMANAGER_H
+
+#include <bitset>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "./Constants.h"
+
+struct InputEvent {
+    Uint32 type;
+    SDL_Keycode keycode;
+    SDL_Scancode scancode;
+    Uint8 button;
+};
+
+struct ActionSnapshot {
+    Uint32 state;
+    Uint32 pressed;
+    Uint32 released;
+};
+
+class InputManager {
+    private:
+        std::bitset<SDL_NUM_SCANCODES> keyState;
+        std::bitset<SDL_NUM_SCANCODES> previousKeyState;
+        std::bitset<SDL_NUM_SCANCODES> framePressedKeys;
+        Uint32 buttonState;
+        Uint32 previousButtonState;
+        InputEvent events[constants::INPUT_EVENT_CAPACITY];
+        unsigned int eventStart;
+        unsigned int eventCount;
+        bool isQuitRequested;
+        unsigned char keyActions[SDL_NUM_SCANCODES];
+        unsigned char buttonActions[SDL_CONTROLLER_BUTTON_MAX];
+        unsigned char actionHoldCount[constants::NUM_ACTIONS];
+        Uint32 actionState;
+        Uint32 actionPressed;
+        Uint32 actionReleased;
+        std::vector<SDL_GameController*> controllers;
+        void PushEvent(const InputEvent& inputEvent);
+        void SetAction(unsigned char action, bool isDown);
+    public:
+        InputManager();
+        ~InputManager();
+        void ClearBindings();
+        void BindKey(constants::ActionType action, SDL_Scancode scancode);
+        void BindControllerButton(constants::ActionType action, SDL_GameControllerButton button);
+        void ProcessEvents();
+        void EndTick();
+        bool IsKeyDown(SDL_Scancode scancode) const;
+        bool WasKeyPressed(SDL_Scancode scancode) const;
+        bool WasKeyReleased(SDL_Scancode scancode) const;
+        bool WasKeyPressedThisFrame(SDL_Scancode scancode) const;
+        bool IsButtonDown(Uint8 button) const;
+        bool WasButtonPressed(Uint8 button) const;
+        bool IsActionDown(constants::ActionType action) const;
+        bool WasActionPressed(constants::ActionType action) const;
+        bool WasActionReleased(constants::ActionType action) const;
+        ActionSnapshot GetActionSnapshot() const;
+        void SetActionSnapshot(const ActionSnapshot& snapshot);
+        bool IsQuitRequested() const;
+        unsigned int GetEventCount() const;
+        const InputEvent& GetEvent(unsigned int index) const;
+};
+
+#endif
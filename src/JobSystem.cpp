@@ -0,0 +1,206 @@
+#include "./JobSystem.h"
+#include "./Profiler.h"
+
+static thread_local unsigned int currentWorkerIndex = 0;
+
+JobSystem::JobSystem(): queuedJobCount(0), isShuttingDown(false) {
+    queues.emplace_back(new WorkQueue());
+    frameStart = std::chrono::steady_clock::now();
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+    for (auto& queue: queues) {
+        delete queue;
+    }
+}
+
+void JobSystem::Initialize(unsigned int workerCount) {
+    Shutdown();
+    isShuttingDown = false;
+    // queue 0 belongs to the thread that owns the job system, workers use 1..workerCount
+    for (unsigned int i = 0; i < workerCount; i++) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (unsigned int i = 1; i <= workerCount; i++) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        isShuttingDown = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+    workers.clear();
+    while (queues.size() > 1) {
+        delete queues.back();
+        queues.pop_back();
+    }
+}
+
+bool JobSystem::IsSingleThreaded() const {
+    return workers.empty();
+}
+
+unsigned int JobSystem::GetWorkerCount() const {
+    return workers.size();
+}
+
+void JobSystem::Submit(const char* name, std::function<void()> function, std::atomic<int>& pendingCount) {
+    pendingCount++;
+    unsigned int queueIndex = currentWorkerIndex < queues.size() ? currentWorkerIndex : 0;
+    {
+        std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->jobs.push_back({name, std::move(function), &pendingCount});
+    }
+    queuedJobCount++;
+    if (!IsSingleThreaded()) {
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wakeCondition.notify_one();
+    }
+}
+
+bool JobSystem::PopJob(unsigned int workerIndex, Job& job) {
+    // own queue is LIFO for locality, except in single-threaded mode where FIFO keeps submission order
+    {
+        WorkQueue& queue = *queues[workerIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            if (IsSingleThreaded()) {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            } else {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            }
+            queuedJobCount--;
+            return true;
+        }
+    }
+    for (unsigned int i = 1; i < queues.size(); i++) {
+        WorkQueue& victim = *queues[(workerIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobCount--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Execute(Job& job, unsigned int workerIndex) {
+    auto start = std::chrono::steady_clock::now();
+    {
+        PROFILE_ZONE(job.name);
+        job.function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    queues[workerIndex]->timings.push_back({
+        job.name,
+        workerIndex,
+        std::chrono::duration<double, std::milli>(start - frameStart).count(),
+        std::chrono::duration<double, std::milli>(end - start).count()
+    });
+    (*job.pendingCount)--;
+}
+
+void JobSystem::WorkerLoop(unsigned int workerIndex) {
+    currentWorkerIndex = workerIndex;
+    Job job;
+    while (true) {
+        if (PopJob(workerIndex, job)) {
+            Execute(job, workerIndex);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() { return queuedJobCount > 0 || isShuttingDown; });
+        if (isShuttingDown) {
+            return;
+        }
+    }
+}
+
+void JobSystem::Wait(std::atomic<int>& pendingCount) {
+    // the waiting thread keeps executing jobs so nested waits never deadlock
+    Job job;
+    while (pendingCount > 0) {
+        if (PopJob(currentWorkerIndex, job)) {
+            Execute(job, currentWorkerIndex);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(const char* name, unsigned int count, unsigned int grainSize, const std::function<void(unsigned int, unsigned int)>& function) {
+    std::atomic<int> pendingCount(0);
+    if (IsSingleThreaded() || count <= grainSize) {
+        Submit(name, [&function, count]() { function(0, count); }, pendingCount);
+    } else {
+        for (unsigned int begin = 0; begin < count; begin += grainSize) {
+            unsigned int end = begin + grainSize < count ? begin + grainSize : count;
+            Submit(name, [&function, begin, end]() { function(begin, end); }, pendingCount);
+        }
+    }
+    Wait(pendingCount);
+}
+
+// both are called between frames by the owning thread, while no jobs are in flight
+void JobSystem::BeginFrame() {
+    for (auto& queue: queues) {
+        queue->timings.clear();
+    }
+    frameStart = std::chrono::steady_clock::now();
+}
+
+std::vector<JobTiming> JobSystem::GetTimings() const {
+    std::vector<JobTiming> timings;
+    for (auto& queue: queues) {
+        timings.insert(timings.end(), queue->timings.begin(), queue->timings.end());
+    }
+    return timings;
+}
+
+unsigned int SystemGraph::AddSystem(const char* name, std::function<void()> function) {
+    systems.push_back({name, std::move(function), std::vector<unsigned int>(), 0});
+    return systems.size() - 1;
+}
+
+void SystemGraph::AddDependency(unsigned int before, unsigned int after) {
+    systems[before].dependents.emplace_back(after);
+    systems[after].dependencyCount++;
+}
+
+void SystemGraph::Schedule(JobSystem& jobSystem, unsigned int systemIndex, std::atomic<int>& pendingCount) {
+    jobSystem.Submit(systems[systemIndex].name, [this, &jobSystem, systemIndex, &pendingCount]() {
+        systems[systemIndex].function();
+        for (auto dependent: systems[systemIndex].dependents) {
+            if (--remainingDependencies[dependent] == 0) {
+                Schedule(jobSystem, dependent, pendingCount);
+            }
+        }
+    }, pendingCount);
+}
+
+void SystemGraph::Run(JobSystem& jobSystem) {
+    if (remainingDependencies.size() != systems.size()) {
+        remainingDependencies = std::vector<std::atomic<int>>(systems.size());
+    }
+    for (unsigned int i = 0; i < systems.size(); i++) {
+        remainingDependencies[i] = systems[i].dependencyCount;
+    }
+    std::atomic<int> pendingCount(0);
+    for (unsigned int i = 0; i < systems.size(); i++) {
+        if (systems[i].dependencyCount == 0) {
+            Schedule(jobSystem, i, pendingCount);
+        }
+    }
+    jobSystem.Wait(pendingCount);
+}
@@ -0,0 +1,74 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct JobTiming {
+    const char* name;
+    unsigned int workerIndex;
+    double startMs;
+    double durationMs;
+};
+
+class JobSystem {
+    private:
+        struct Job {
+            const char* name;
+            std::function<void()> function;
+            std::atomic<int>* pendingCount;
+        };
+        // timings are only appended by the thread that owns the queue, so recording them takes no lock
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+            std::vector<JobTiming> timings;
+        };
+        std::vector<std::thread> workers;
+        std::vector<WorkQueue*> queues;
+        std::mutex sleepMutex;
+        std::condition_variable wakeCondition;
+        std::atomic<int> queuedJobCount;
+        std::atomic<bool> isShuttingDown;
+        std::chrono::steady_clock::time_point frameStart;
+        void WorkerLoop(unsigned int workerIndex);
+        bool PopJob(unsigned int workerIndex, Job& job);
+        void Execute(Job& job, unsigned int workerIndex);
+    public:
+        JobSystem();
+        ~JobSystem();
+        void Initialize(unsigned int workerCount);
+        void Shutdown();
+        bool IsSingleThreaded() const;
+        unsigned int GetWorkerCount() const;
+        void Submit(const char* name, std::function<void()> function, std::atomic<int>& pendingCount);
+        void Wait(std::atomic<int>& pendingCount);
+        void ParallelFor(const char* name, unsigned int count, unsigned int grainSize, const std::function<void(unsigned int, unsigned int)>& function);
+        void BeginFrame();
+        std::vector<JobTiming> GetTimings() const;
+};
+
+class SystemGraph {
+    private:
+        struct System {
+            const char* name;
+            std::function<void()> function;
+            std::vector<unsigned int> dependents;
+            unsigned int dependencyCount;
+        };
+        std::vector<System> systems;
+        std::vector<std::atomic<int>> remainingDependencies;
+        void Schedule(JobSystem& jobSystem, unsigned int systemIndex, std::atomic<int>& pendingCount);
+    public:
+        unsigned int AddSystem(const char* name, std::function<void()> function);
+        void AddDependency(unsigned int before, unsigned int after);
+        void Run(JobSystem& jobSystem);
+};
+
+#endif
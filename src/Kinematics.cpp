@@ -0,0 +1,127 @@
+#include <SDL2/SDL.h>
+#include "./Kinematics.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define KINEMATICS_X86
+#include <immintrin.h>
+#endif
+
+#if defined(KINEMATICS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define KINEMATICS_AVX2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+typedef void (*IntegrateKernel)(float*, float*, const float*, const float*, unsigned int, unsigned int, float);
+typedef void (*RangeKernel)(const float*, const float*, const float*, const float*, const float*, unsigned char*, unsigned int, unsigned int);
+
+static void IntegrateScalar(float* positionX, float* positionY, const float* velocityX, const float* velocityY, unsigned int begin, unsigned int count, float deltaTime) {
+    for (unsigned int i = begin; i < count; i++) {
+        positionX[i] += velocityX[i] * deltaTime;
+        positionY[i] += velocityY[i] * deltaTime;
+    }
+}
+
+static void FindOutOfRangeScalar(const float* positionX, const float* positionY, const float* originX, const float* originY, const float* rangeSquared, unsigned char* isOutOfRange, unsigned int begin, unsigned int count) {
+    for (unsigned int i = begin; i < count; i++) {
+        float dx = positionX[i] - originX[i];
+        float dy = positionY[i] - originY[i];
+        isOutOfRange[i] = (dx * dx + dy * dy) > rangeSquared[i];
+    }
+}
+
+#ifdef KINEMATICS_X86
+static void IntegrateSSE2(float* positionX, float* positionY, const float* velocityX, const float* velocityY, unsigned int begin, unsigned int count, float deltaTime) {
+    __m128 dt = _mm_set1_ps(deltaTime);
+    unsigned int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(positionX + i);
+        __m128 py = _mm_loadu_ps(positionY + i);
+        px = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(velocityX + i), dt));
+        py = _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(velocityY + i), dt));
+        _mm_storeu_ps(positionX + i, px);
+        _mm_storeu_ps(positionY + i, py);
+    }
+    IntegrateScalar(positionX, positionY, velocityX, velocityY, i, count, deltaTime);
+}
+
+static void FindOutOfRangeSSE2(const float* positionX, const float* positionY, const float* originX, const float* originY, const float* rangeSquared, unsigned char* isOutOfRange, unsigned int begin, unsigned int count) {
+    unsigned int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(positionX + i), _mm_loadu_ps(originX + i));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(positionY + i), _mm_loadu_ps(originY + i));
+        __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(distanceSquared, _mm_loadu_ps(rangeSquared + i)));
+        for (int lane = 0; lane < 4; lane++) {
+            isOutOfRange[i + lane] = (mask >> lane) & 1;
+        }
+    }
+    FindOutOfRangeScalar(positionX, positionY, originX, originY, rangeSquared, isOutOfRange, i, count);
+}
+#endif
+
+#ifdef KINEMATICS_AVX2
+TARGET_AVX2 static void IntegrateAVX2(float* positionX, float* positionY, const float* velocityX, const float* velocityY, unsigned int begin, unsigned int count, float deltaTime) {
+    __m256 dt = _mm256_set1_ps(deltaTime);
+    unsigned int i = begin;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(positionX + i);
+        __m256 py = _mm256_loadu_ps(positionY + i);
+        px = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(velocityX + i), dt));
+        py = _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(velocityY + i), dt));
+        _mm256_storeu_ps(positionX + i, px);
+        _mm256_storeu_ps(positionY + i, py);
+    }
+    IntegrateSSE2(positionX, positionY, velocityX, velocityY, i, count, deltaTime);
+}
+
+TARGET_AVX2 static void FindOutOfRangeAVX2(const float* positionX, const float* positionY, const float* originX, const float* originY, const float* rangeSquared, unsigned char* isOutOfRange, unsigned int begin, unsigned int count) {
+    unsigned int i = begin;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(positionX + i), _mm256_loadu_ps(originX + i));
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(positionY + i), _mm256_loadu_ps(originY + i));
+        __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, _mm256_loadu_ps(rangeSquared + i), _CMP_GT_OQ));
+        for (int lane = 0; lane < 8; lane++) {
+            isOutOfRange[i + lane] = (mask >> lane) & 1;
+        }
+    }
+    FindOutOfRangeSSE2(positionX, positionY, originX, originY, rangeSquared, isOutOfRange, i, count);
+}
+#endif
+
+struct KinematicsKernels {
+    IntegrateKernel integrate;
+    RangeKernel findOutOfRange;
+    const char* instructionSet;
+};
+
+static KinematicsKernels SelectKernels() {
+#ifdef KINEMATICS_AVX2
+    if (SDL_HasAVX2()) {
+        return {IntegrateAVX2, FindOutOfRangeAVX2, "AVX2"};
+    }
+#endif
+#ifdef KINEMATICS_X86
+    if (SDL_HasSSE2()) {
+        return {IntegrateSSE2, FindOutOfRangeSSE2, "SSE2"};
+    }
+#endif
+    return {IntegrateScalar, FindOutOfRangeScalar, "scalar"};
+}
+
+static const KinematicsKernels& GetKernels() {
+    static const KinematicsKernels kernels = SelectKernels();
+    return kernels;
+}
+
+void Kinematics::Integrate(float* positionX, float* positionY, const float* velocityX, const float* velocityY, unsigned int count, float deltaTime) {
+    GetKernels().integrate(positionX, positionY, velocityX, velocityY, 0, count, deltaTime);
+}
+
+void Kinematics::FindOutOfRange(const float* positionX, const float* positionY, const float* originX, const float* originY, const float* rangeSquared, unsigned char* isOutOfRange, unsigned int count) {
+    GetKernels().findOutOfRange(positionX, positionY, originX, originY, rangeSquared, isOutOfRange, 0, count);
+}
+
+const char* Kinematics::GetInstructionSet() {
+    return GetKernels().instructionSet;
+}
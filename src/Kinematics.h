@@ -0,0 +1,26 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+class Kinematics {
+    public:
+        static void Integrate(
+            float* positionX,
+            float* positionY,
+            const float* velocityX,
+            const float* velocityY,
+            unsigned int count,
+            float deltaTime
+        );
+        static void FindOutOfRange(
+            const float* positionX,
+            const float* positionY,
+            const float* originX,
+            const float* originY,
+            const float* rangeSquared,
+            unsigned char* isOutOfRange,
+            unsigned int count
+        );
+        static const char* GetInstructionSet();
+};
+
+#endif
@@ -1,14 +1,83 @@
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <thread>
 #include "./Constants.h"
 #include "./Game.h"
+#include "./Metrics.h"
+#include "./Profiler.h"
+
+// numeric options must be whole numbers no smaller than minimum, anything else is reported and rejected
+static bool ParseInteger(const std::string& argument, const std::string& value, long minimum, long& result) {
+    char* end = NULL;
+    result = std::strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || result < minimum) {
+        std::cerr << "Invalid value in " << argument << ", expected a whole number of at least " << minimum << "." << std::endl;
+        return false;
+    }
+    return true;
+}
 
 int main(int argc, char *args[]) {
     Game *game = new Game();
+    for (int i = 1; i < argc; i++) {
+        std::string argument = args[i];
+        // --jobs=0 runs every system on the main thread in a deterministic order
+        // more workers than hardware threads only adds contention, so the count is clamped
+        if (argument.compare(0, 7, "--jobs=") == 0) {
+            long workerCount = 0;
+            if (!ParseInteger(argument, argument.substr(7), 0, workerCount)) {
+                return 1;
+            }
+            long hardwareThreads = std::thread::hardware_concurrency();
+            if (hardwareThreads > 0 && workerCount > hardwareThreads) {
+                workerCount = hardwareThreads;
+            }
+            game->SetWorkerCount(static_cast<unsigned int>(workerCount));
+        }
+        if (argument.compare(0, 12, "--tick-rate=") == 0) {
+            long tickRate = 0;
+            if (!ParseInteger(argument, argument.substr(12), 1, tickRate)) {
+                return 1;
+            }
+            game->SetTickRate(static_cast<unsigned int>(tickRate));
+        }
+        if (argument.compare(0, 9, "--record=") == 0) {
+            game->SetRecordFile(argument.substr(9));
+        }
+        if (argument.compare(0, 9, "--replay=") == 0) {
+            game->SetReplayFile(argument.substr(9));
+        }
+        if (argument.compare(0, 8, "--trace=") == 0) {
+            game->SetTraceFile(argument.substr(8));
+        }
+        if (argument.compare(0, 10, "--metrics=") == 0) {
+            game->SetMetricsFile(argument.substr(10));
+        }
+        if (argument.compare("--headless") == 0) {
+            game->SetHeadless(true);
+        }
+        if (argument.compare(0, 8, "--ticks=") == 0) {
+            long tickLimit = 0;
+            if (!ParseInteger(argument, argument.substr(8), 1, tickLimit)) {
+                return 1;
+            }
+            game->SetTickLimit(static_cast<unsigned int>(tickLimit));
+        }
+        if (argument.compare("--vsync") == 0) {
+            game->SetFrameMode(constants::FRAME_VSYNC);
+        }
+        if (argument.compare("--uncapped") == 0) {
+            game->SetFrameMode(constants::FRAME_UNCAPPED);
+        }
+    }
     game->Initialize(constants::WINDOW_WIDTH, constants::WINDOW_HEIGHT);
     while(game->IsRunning()) {
         game->ProcessInput();
         game->Update();
         game->Render();
+        Metrics::EndFrame();
+        PROFILE_END_FRAME();
     }
     game->Destroy();
     return 0;
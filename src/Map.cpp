@@ -3,6 +3,7 @@
 #include "./Map.h"
 #include "./Game.h"
 #include "./EntityManager.h"
+#include "./AssetManager.h"
 #include "./Components/TileComponent.h"
 
 extern EntityManager manager;
@@ -11,6 +12,14 @@ Map::Map(std::string textureId, int scale, int tileSize) {
     this->textureId = textureId;
     this->scale = scale;
     this->tileSize = tileSize;
+    this->bounds = {0, 0, 0, 0};
+    this->overview = NULL;
+}
+
+Map::~Map() {
+    if (overview) {
+        SDL_DestroyTexture(overview);
+    }
 }
 
 void Map::LoadMap(std::string filePath, int mapSizeX, int mapSizeY) {
@@ -31,10 +40,48 @@ void Map::LoadMap(std::string filePath, int mapSizeX, int mapSizeY) {
     }
 
     mapFile.close();
+    bounds = {0, 0, mapSizeX * scale * tileSize, mapSizeY * scale * tileSize};
+}
+
+const SDL_Rect& Map::GetBounds() const {
+    return bounds;
+}
+
+// the whole tilemap is drawn once into a small target texture, so showing it later costs a single copy
+// no matter how many tiles the level has
+SDL_Texture* Map::GetOverview(int width, int height) {
+    if (overview || !Game::renderer || bounds.w == 0 || bounds.h == 0) {
+        return overview;
+    }
+    SDL_Texture* tileTexture = Game::assetManager->GetTexture(textureId);
+    overview = SDL_CreateTexture(Game::renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!tileTexture || !overview) {
+        std::cerr << "Error creating map overview: " << SDL_GetError() << std::endl;
+        return overview;
+    }
+    SDL_SetTextureScaleMode(tileTexture, SDL_ScaleModeLinear);
+    SDL_SetTextureScaleMode(overview, SDL_ScaleModeLinear);
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(Game::renderer);
+    SDL_SetRenderTarget(Game::renderer, overview);
+    SDL_SetRenderDrawColor(Game::renderer, 0, 0, 0, 255);
+    SDL_RenderClear(Game::renderer);
+    float scaleX = static_cast<float>(width) / bounds.w;
+    float scaleY = static_cast<float>(height) / bounds.h;
+    float tileWidth = tileSize * scale * scaleX;
+    float tileHeight = tileSize * scale * scaleY;
+    for (auto &tile: tiles) {
+        SDL_FRect destination = {tile.position.x * scaleX, tile.position.y * scaleY, tileWidth, tileHeight};
+        SDL_RenderCopyF(Game::renderer, tileTexture, &tile.source, &destination);
+    }
+    SDL_SetRenderTarget(Game::renderer, previousTarget);
+    SDL_SetTextureScaleMode(tileTexture, SDL_ScaleModeNearest);
+    return overview;
 }
 
 void Map::AddTile(int sourceRectX, int sourceRectY, int x, int y) {
     // todo: add a new tile entity into the game scene
     Entity& newTile(manager.AddEntity("Tile", constants::TILEMAP_LAYER)); 
     newTile.AddComponent<TileComponent>(sourceRectX, sourceRectY, x, y, tileSize, scale, textureId);
+    newTile.SetStatic(true);
+    tiles.push_back({{sourceRectX, sourceRectY, tileSize, tileSize}, {x, y}});
 }
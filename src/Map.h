@@ -2,17 +2,29 @@
 #define MAP_H
 
 #include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+struct MapTile {
+    SDL_Rect source;
+    SDL_Point position;
+};
 
 class Map {
     private:
         std::string textureId;
         int scale;
         int tileSize;
+        SDL_Rect bounds;
+        std::vector<MapTile> tiles;
+        SDL_Texture* overview;
     public: 
         Map(std::string textureId, int scale, int tileSize);
         ~Map();
         void LoadMap(std::string filePath, int mapSizeX, int mapSizeY);
         void AddTile(int sourceX, int sourceY, int x, int y);
+        const SDL_Rect& GetBounds() const;
+        SDL_Texture* GetOverview(int width, int height);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include "./Metrics.h"
+#include "./Profiler.h"
+
+Metric Metrics::metrics[constants::MAX_METRICS];
+std::atomic<unsigned int> Metrics::metricCount(0);
+std::mutex Metrics::registerMutex;
+std::ofstream Metrics::csvFile;
+unsigned int Metrics::frameNumber = 0;
+
+static std::atomic<unsigned long long> allocationCount(0);
+static std::atomic<unsigned long long> allocatedBytes(0);
+
+// replacing the global allocation functions is the only way to see allocations made inside std containers and sol,
+// every form is replaced so no path falls back to the library allocator and frees memory it did not allocate
+static void* CountedAllocate(std::size_t size) noexcept {
+    Metrics::CountAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size) {
+    void* memory = CountedAllocate(size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    void* memory = CountedAllocate(size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+unsigned int Metrics::Register(const std::string& name, MetricKind kind) {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    unsigned int count = metricCount;
+    for (unsigned int i = 0; i < count; i++) {
+        if (metrics[i].name == name) {
+            return i;
+        }
+    }
+    if (count == constants::MAX_METRICS) {
+        std::cerr << "Too many metrics, dropping " << name << std::endl;
+        return constants::MAX_METRICS - 1;
+    }
+    metrics[count] = {name, kind, 0.0, 0.0};
+    metricCount = count + 1;
+    return count;
+}
+
+// each metric has a single writer at a time (one system or the render pass), so updates are not locked
+void Metrics::Add(unsigned int id, double delta) {
+    metrics[id].value += delta;
+}
+
+void Metrics::Set(unsigned int id, double value) {
+    metrics[id].value = value;
+}
+
+void Metrics::CountAllocation(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void Metrics::EndFrame() {
+    static const unsigned int allocations = Register("allocations", METRIC_COUNTER);
+    static const unsigned int allocationBytes = Register("allocated bytes", METRIC_COUNTER);
+    Set(allocations, static_cast<double>(allocationCount.exchange(0, std::memory_order_relaxed)));
+    Set(allocationBytes, static_cast<double>(allocatedBytes.exchange(0, std::memory_order_relaxed)));
+
+    unsigned int count = metricCount;
+    for (unsigned int i = 0; i < count; i++) {
+        Metric& metric = metrics[i];
+        metric.frameValue = metric.value;
+        if (metric.kind == METRIC_COUNTER) {
+            metric.value = 0.0;
+        }
+        PROFILE_COUNTER(metric.name.c_str(), metric.frameValue);
+        if (csvFile.is_open()) {
+            csvFile << frameNumber << "," << metric.name << "," << metric.frameValue << "\n";
+        }
+    }
+    frameNumber++;
+}
+
+unsigned int Metrics::GetCount() {
+    return metricCount;
+}
+
+const Metric& Metrics::Get(unsigned int id) {
+    return metrics[id];
+}
+
+void Metrics::Print(std::ostream& stream) {
+    stream << "Metrics at frame " << frameNumber << std::endl;
+    unsigned int count = metricCount;
+    for (unsigned int i = 0; i < count; i++) {
+        stream << "  " << std::left << std::setw(32) << metrics[i].name << metrics[i].frameValue << std::endl;
+    }
+}
+
+bool Metrics::OpenCsv(const std::string& filePath) {
+    csvFile.open(filePath.c_str(), std::ios::out | std::ios::trunc);
+    if (!csvFile.is_open()) {
+        std::cerr << "Error opening metrics file " << filePath << std::endl;
+        return false;
+    }
+    csvFile << "frame,metric,value\n";
+    return true;
+}
+
+void Metrics::CloseCsv() {
+    if (csvFile.is_open()) {
+        csvFile.close();
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "./Constants.h"
+
+enum MetricKind {
+    METRIC_COUNTER, // accumulates during a frame and starts the next frame at zero
+    METRIC_GAUGE    // keeps its last value until it is set again
+};
+
+struct Metric {
+    std::string name;
+    MetricKind kind;
+    double value;
+    double frameValue;
+};
+
+// every subsystem registers its numbers once and updates them by id, the registry publishes a
+// snapshot at the end of each frame to the debug console, the csv dump and the profiler trace
+class Metrics {
+    private:
+        static Metric metrics[constants::MAX_METRICS];
+        static std::atomic<unsigned int> metricCount;
+        static std::mutex registerMutex;
+        static std::ofstream csvFile;
+        static unsigned int frameNumber;
+    public:
+        static unsigned int Register(const std::string& name, MetricKind kind);
+        static void Add(unsigned int id, double delta);
+        static void Set(unsigned int id, double value);
+        static void CountAllocation(std::size_t size);
+        static void EndFrame();
+        static unsigned int GetCount();
+        static const Metric& Get(unsigned int id);
+        static void Print(std::ostream& stream);
+        static bool OpenCsv(const std::string& filePath);
+        static void CloseCsv();
+};
+
+#endif
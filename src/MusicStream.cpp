@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <iostream>
+#include <SDL2/SDL_mixer.h>
+#include "./MusicStream.h"
+
+static Uint32 ReadLittleEndian(const unsigned char* bytes, unsigned int size) {
+    Uint32 value = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        value |= static_cast<Uint32>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+MusicStream::MusicStream() {
+    frequency = 0;
+    channels = 0;
+    isRunning = false;
+    hasRequest = false;
+    requestFadeMs = 0;
+    requestLooping = false;
+    for (auto& deck: decks) {
+        deck.state = DECK_IDLE;
+        deck.converter = NULL;
+        deck.dataStart = 0;
+        deck.dataSize = 0;
+        deck.dataRemaining = 0;
+        deck.isLooping = false;
+        deck.isFinished = true;
+        deck.readIndex = 0;
+        deck.writeIndex = 0;
+        deck.fadeStep = 1.0f;
+        deck.gain = 0.0f;
+    }
+}
+
+MusicStream::~MusicStream() {
+    Shutdown();
+}
+
+bool MusicStream::Start() {
+    Uint16 format;
+    if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+        return false;
+    }
+    // the hook mixes straight into the device buffer, which the manager opens as 16 bit samples
+    if (format != AUDIO_S16SYS) {
+        std::cerr << "Music streaming needs a 16 bit audio device" << std::endl;
+        return false;
+    }
+    isRunning = true;
+    decoder = std::thread(&MusicStream::RunDecoder, this);
+    Mix_HookMusic(&MusicStream::MixCallback, this);
+    return true;
+}
+
+void MusicStream::Shutdown() {
+    if (!isRunning) {
+        return;
+    }
+    Mix_HookMusic(NULL, NULL);
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        isRunning = false;
+    }
+    requestCondition.notify_one();
+    decoder.join();
+    for (auto& deck: decks) {
+        CloseTrack(deck);
+        deck.state = DECK_IDLE;
+    }
+}
+
+void MusicStream::Play(const std::string& filePath, int fadeMs, bool isLooping) {
+    if (!isRunning) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        hasRequest = true;
+        requestPath = filePath;
+        requestFadeMs = fadeMs;
+        requestLooping = isLooping;
+    }
+    requestCondition.notify_one();
+}
+
+void MusicStream::Stop(int fadeMs) {
+    Play("", fadeMs, false);
+}
+
+float MusicStream::GetFadeStep(int fadeMs) const {
+    float fadeFrames = fadeMs * frequency / 1000.0f;
+    return fadeFrames >= 1.0f ? 1.0f / fadeFrames : 1.0f;
+}
+
+void MusicStream::RunDecoder() {
+    std::unique_lock<std::mutex> lock(requestMutex);
+    while (isRunning) {
+        requestCondition.wait_for(lock, std::chrono::milliseconds(constants::MUSIC_DECODE_INTERVAL_MS));
+        if (!isRunning) {
+            break;
+        }
+        // a new track waits for a free deck, which at most means waiting for the previous crossfade to finish
+        if (hasRequest) {
+            MusicDeck* freeDeck = NULL;
+            for (auto& deck: decks) {
+                if (deck.state == DECK_IDLE) {
+                    freeDeck = &deck;
+                }
+            }
+            if (freeDeck) {
+                std::string filePath = requestPath;
+                int fadeMs = requestFadeMs;
+                bool isLooping = requestLooping;
+                hasRequest = false;
+                lock.unlock();
+                for (auto& deck: decks) {
+                    int playing = DECK_PLAYING;
+                    deck.fadeStep = GetFadeStep(fadeMs);
+                    deck.state.compare_exchange_strong(playing, DECK_STOPPING);
+                }
+                if (!filePath.empty() && OpenTrack(*freeDeck, filePath, isLooping)) {
+                    FillRing(*freeDeck);
+                    freeDeck->fadeStep = GetFadeStep(fadeMs);
+                    freeDeck->state = DECK_PLAYING;
+                }
+                lock.lock();
+            }
+        }
+        lock.unlock();
+        for (auto& deck: decks) {
+            if (deck.state == DECK_IDLE) {
+                CloseTrack(deck);
+            } else {
+                FillRing(deck);
+            }
+        }
+        lock.lock();
+    }
+}
+
+bool MusicStream::OpenTrack(MusicDeck& deck, const std::string& filePath, bool isLooping) {
+    CloseTrack(deck);
+    deck.file.open(filePath.c_str(), std::ios::in | std::ios::binary);
+    unsigned char header[12];
+    if (!deck.file.read(reinterpret_cast<char*>(header), 12) ||
+        std::string(reinterpret_cast<char*>(header), 4) != "RIFF" ||
+        std::string(reinterpret_cast<char*>(header) + 8, 4) != "WAVE") {
+        std::cerr << "Error opening music " << filePath << ", only wav tracks can be streamed" << std::endl;
+        CloseTrack(deck);
+        return false;
+    }
+
+    // walk the chunks until the sample format and the start of the sample data are known
+    SDL_AudioFormat format = 0;
+    int trackChannels = 0;
+    int trackFrequency = 0;
+    unsigned char chunkHeader[8];
+    while (deck.file.read(reinterpret_cast<char*>(chunkHeader), 8)) {
+        std::string chunkId(reinterpret_cast<char*>(chunkHeader), 4);
+        Uint32 chunkSize = ReadLittleEndian(chunkHeader + 4, 4);
+        if (chunkId == "fmt ") {
+            unsigned char formatChunk[16];
+            if (chunkSize < 16 || !deck.file.read(reinterpret_cast<char*>(formatChunk), 16)) {
+                break;
+            }
+            Uint32 encoding = ReadLittleEndian(formatChunk, 2);
+            Uint32 bitsPerSample = ReadLittleEndian(formatChunk + 14, 2);
+            trackChannels = ReadLittleEndian(formatChunk + 2, 2);
+            trackFrequency = ReadLittleEndian(formatChunk + 4, 4);
+            if (encoding == 3 && bitsPerSample == 32) {
+                format = AUDIO_F32LSB;
+            } else if (bitsPerSample == 8) {
+                format = AUDIO_U8;
+            } else if (bitsPerSample == 16) {
+                format = AUDIO_S16LSB;
+            } else if (bitsPerSample == 32) {
+                format = AUDIO_S32LSB;
+            }
+            deck.file.seekg(chunkSize - 16 + (chunkSize & 1), std::ios::cur);
+        } else if (chunkId == "data") {
+            deck.dataStart = deck.file.tellg();
+            deck.dataSize = chunkSize;
+            break;
+        } else {
+            deck.file.seekg(chunkSize + (chunkSize & 1), std::ios::cur);
+        }
+    }
+    if (format == 0 || trackChannels == 0 || deck.dataSize == 0) {
+        std::cerr << "Error reading music " << filePath << ", unsupported wav format" << std::endl;
+        CloseTrack(deck);
+        return false;
+    }
+    deck.converter = SDL_NewAudioStream(format, trackChannels, trackFrequency, AUDIO_S16SYS, channels, frequency);
+    if (!deck.converter) {
+        std::cerr << "Error converting music " << filePath << ": " << SDL_GetError() << std::endl;
+        CloseTrack(deck);
+        return false;
+    }
+    deck.dataRemaining = deck.dataSize;
+    deck.isLooping = isLooping;
+    deck.isFinished = false;
+    deck.readIndex = 0;
+    deck.writeIndex = 0;
+    deck.gain = 0.0f;
+    return true;
+}
+
+void MusicStream::CloseTrack(MusicDeck& deck) {
+    if (deck.file.is_open()) {
+        deck.file.close();
+    }
+    deck.file.clear();
+    if (deck.converter) {
+        SDL_FreeAudioStream(deck.converter);
+        deck.converter = NULL;
+    }
+    deck.dataSize = 0;
+    deck.dataRemaining = 0;
+    deck.isFinished = true;
+}
+
+void MusicStream::FillRing(MusicDeck& deck) {
+    if (!deck.converter) {
+        return;
+    }
+    Sint16 samples[constants::MUSIC_BLOCK_BYTES / sizeof(Sint16)];
+    char block[constants::MUSIC_BLOCK_BYTES];
+    const unsigned int frameBytes = channels * sizeof(Sint16);
+    while (true) {
+        unsigned int freeSamples = constants::MUSIC_RING_SAMPLES - (deck.writeIndex - deck.readIndex);
+        unsigned int wantedBytes = std::min<unsigned int>(freeSamples * sizeof(Sint16), sizeof(samples)) / frameBytes * frameBytes;
+        if (wantedBytes == 0) {
+            return;
+        }
+        // the converter is only topped up when drained, so it never buffers more than a block or two
+        if (SDL_AudioStreamAvailable(deck.converter) < static_cast<int>(wantedBytes)) {
+            if (deck.dataRemaining == 0 && deck.isLooping) {
+                deck.file.clear();
+                deck.file.seekg(deck.dataStart);
+                deck.dataRemaining = deck.dataSize;
+            }
+            if (deck.dataRemaining > 0) {
+                unsigned int readBytes = std::min<unsigned int>(deck.dataRemaining, sizeof(block));
+                deck.file.read(block, readBytes);
+                readBytes = static_cast<unsigned int>(deck.file.gcount());
+                deck.dataRemaining = readBytes > 0 ? deck.dataRemaining - readBytes : 0;
+                SDL_AudioStreamPut(deck.converter, block, readBytes);
+                continue;
+            }
+            SDL_AudioStreamFlush(deck.converter);
+        }
+        int gotBytes = SDL_AudioStreamGet(deck.converter, samples, wantedBytes);
+        if (gotBytes <= 0) {
+            deck.isFinished = deck.dataRemaining == 0;
+            return;
+        }
+        unsigned int writeIndex = deck.writeIndex.load(std::memory_order_relaxed);
+        for (unsigned int i = 0; i < gotBytes / sizeof(Sint16); i++) {
+            deck.ring[(writeIndex + i) % constants::MUSIC_RING_SAMPLES] = samples[i];
+        }
+        deck.writeIndex.store(writeIndex + gotBytes / sizeof(Sint16), std::memory_order_release);
+    }
+}
+
+void MusicStream::MixCallback(void* userData, Uint8* stream, int length) {
+    MusicStream* musicStream = static_cast<MusicStream*>(userData);
+    Sint16* output = reinterpret_cast<Sint16*>(stream);
+    const unsigned int channels = musicStream->channels;
+    const unsigned int sampleCount = length / sizeof(Sint16);
+    std::fill(output, output + sampleCount, 0);
+    for (auto& deck: musicStream->decks) {
+        int state = deck.state.load(std::memory_order_acquire);
+        if (state == DECK_IDLE) {
+            continue;
+        }
+        float target = state == DECK_PLAYING ? 1.0f : 0.0f;
+        float fadeStep = deck.fadeStep.load(std::memory_order_relaxed);
+        unsigned int readIndex = deck.readIndex.load(std::memory_order_relaxed);
+        unsigned int available = deck.writeIndex.load(std::memory_order_acquire) - readIndex;
+        unsigned int mixCount = std::min(sampleCount, available / channels * channels);
+        for (unsigned int frame = 0; frame < mixCount; frame += channels) {
+            deck.gain = target > deck.gain ? std::min(deck.gain + fadeStep, target) : std::max(deck.gain - fadeStep, target);
+            for (unsigned int channel = 0; channel < channels; channel++) {
+                int sample = output[frame + channel] + static_cast<int>(deck.ring[(readIndex + frame + channel) % constants::MUSIC_RING_SAMPLES] * deck.gain);
+                output[frame + channel] = static_cast<Sint16>(std::max(-32768, std::min(32767, sample)));
+            }
+        }
+        deck.readIndex.store(readIndex + mixCount, std::memory_order_release);
+        // a faded out deck, or one that has played to the end, goes back to the decoder
+        if ((state == DECK_STOPPING && deck.gain <= 0.0f) || (mixCount == available && deck.isFinished)) {
+            deck.gain = 0.0f;
+            deck.state.store(DECK_IDLE, std::memory_order_release);
+        }
+    }
+}
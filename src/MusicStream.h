@@ -0,0 +1,65 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <SDL2/SDL.h>
+#include "./Constants.h"
+
+enum MusicDeckState {
+    DECK_IDLE,     // owned by the decoder thread, the mixer ignores it
+    DECK_PLAYING,  // the mixer reads and fades it in, the decoder keeps its ring filled
+    DECK_STOPPING  // the mixer fades it out and hands it back as idle
+};
+
+struct MusicDeck {
+    std::atomic<int> state;
+    std::ifstream file;
+    SDL_AudioStream* converter;
+    std::streamoff dataStart;
+    Uint32 dataSize;
+    Uint32 dataRemaining;
+    bool isLooping;
+    std::atomic<bool> isFinished;
+    Sint16 ring[constants::MUSIC_RING_SAMPLES];
+    std::atomic<unsigned int> readIndex;
+    std::atomic<unsigned int> writeIndex;
+    std::atomic<float> fadeStep;
+    float gain;
+};
+
+// tracks are decoded from disk in small blocks on a background thread into fixed rings that the mixer
+// drains from its music hook, so memory stays the same for any track length and loading never waits on audio
+class MusicStream {
+    private:
+        MusicDeck decks[2];
+        int frequency;
+        int channels;
+        bool isRunning;
+        std::thread decoder;
+        std::mutex requestMutex;
+        std::condition_variable requestCondition;
+        bool hasRequest;
+        std::string requestPath;
+        int requestFadeMs;
+        bool requestLooping;
+        void RunDecoder();
+        bool OpenTrack(MusicDeck& deck, const std::string& filePath, bool isLooping);
+        void CloseTrack(MusicDeck& deck);
+        void FillRing(MusicDeck& deck);
+        float GetFadeStep(int fadeMs) const;
+        static void MixCallback(void* userData, Uint8* stream, int length);
+    public:
+        MusicStream();
+        ~MusicStream();
+        bool Start();
+        void Shutdown();
+        void Play(const std::string& filePath, int fadeMs, bool isLooping);
+        void Stop(int fadeMs);
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "./ParticleSystem.h"
+#include "./Game.h"
+#include "./Kinematics.h"
+#include "./Metrics.h"
+#include "./Profiler.h"
+
+ParticleSystem::ParticleSystem(): count(0), random(constants::PARTICLE_SEED), texture(NULL) {
+    positionX.resize(constants::PARTICLE_CAPACITY);
+    positionY.resize(constants::PARTICLE_CAPACITY);
+    velocityX.resize(constants::PARTICLE_CAPACITY);
+    velocityY.resize(constants::PARTICLE_CAPACITY);
+    accelerationX.resize(constants::PARTICLE_CAPACITY);
+    accelerationY.resize(constants::PARTICLE_CAPACITY);
+    age.resize(constants::PARTICLE_CAPACITY);
+    lifetime.resize(constants::PARTICLE_CAPACITY);
+    definition.resize(constants::PARTICLE_CAPACITY);
+}
+
+ParticleSystem::~ParticleSystem() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+// the only particle texture is a soft white dot made here, emitters tint it through the vertex colour
+void ParticleSystem::Initialize() {
+    if (!Game::renderer || texture) {
+        return;
+    }
+    const int size = constants::PARTICLE_TEXTURE_SIZE;
+    std::vector<Uint32> pixels(size * size);
+    float radius = size * 0.5f;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float distance = std::sqrt((x + 0.5f - radius) * (x + 0.5f - radius) + (y + 0.5f - radius) * (y + 0.5f - radius)) / radius;
+            float alpha = glm::clamp(1.0f - distance, 0.0f, 1.0f);
+            pixels[y * size + x] = 0xFFFFFF00 | static_cast<Uint32>(alpha * alpha * 255.0f);
+        }
+    }
+    texture = SDL_CreateTexture(Game::renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, size, size);
+    if (!texture) {
+        std::cerr << "Error creating particle texture: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_UpdateTexture(texture, NULL, pixels.data(), size * sizeof(Uint32));
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+void ParticleSystem::Clear() {
+    std::lock_guard<std::mutex> lock(spawnMutex);
+    spawns.clear();
+    count = 0;
+}
+
+unsigned int ParticleSystem::AddDefinition(const ParticleEmitterDefinition& definition) {
+    definitions.push_back(definition);
+    return definitions.size() - 1;
+}
+
+const ParticleEmitterDefinition& ParticleSystem::GetDefinition(unsigned int definition) const {
+    return definitions[definition];
+}
+
+// emitters run inside the parallel component update, so requests are queued and spawned by Update
+void ParticleSystem::Emit(unsigned int definition, const glm::vec2& position, unsigned int count) {
+    if (definition >= definitions.size() || count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(spawnMutex);
+    spawns.push_back({definition, position, count});
+}
+
+float ParticleSystem::RandomRange(float center, float variance) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    return center + variance * distribution(random);
+}
+
+void ParticleSystem::Spawn(const ParticleSpawn& spawn) {
+    const ParticleEmitterDefinition& emitter = definitions[spawn.definition];
+    unsigned int spawnCount = std::min(spawn.count, constants::PARTICLE_CAPACITY - count);
+    for (unsigned int n = 0; n < spawnCount; n++) {
+        unsigned int i = count++;
+        float angle = glm::radians(RandomRange(emitter.direction, emitter.spread * 0.5f));
+        float speed = std::max(RandomRange(emitter.speed, emitter.speedVariance), 0.0f);
+        positionX[i] = spawn.position.x;
+        positionY[i] = spawn.position.y;
+        velocityX[i] = std::cos(angle) * speed;
+        velocityY[i] = std::sin(angle) * speed;
+        accelerationX[i] = emitter.gravity.x;
+        accelerationY[i] = emitter.gravity.y;
+        age[i] = 0.0f;
+        lifetime[i] = std::max(RandomRange(emitter.lifetime, emitter.lifetimeVariance), 0.01f);
+        definition[i] = static_cast<unsigned short>(spawn.definition);
+    }
+}
+
+// the last live particle is moved into the dead one's slot so the arrays stay packed
+void ParticleSystem::Kill(unsigned int index) {
+    unsigned int last = --count;
+    positionX[index] = positionX[last];
+    positionY[index] = positionY[last];
+    velocityX[index] = velocityX[last];
+    velocityY[index] = velocityY[last];
+    accelerationX[index] = accelerationX[last];
+    accelerationY[index] = accelerationY[last];
+    age[index] = age[last];
+    lifetime[index] = lifetime[last];
+    definition[index] = definition[last];
+}
+
+void ParticleSystem::Update(float deltaTime) {
+    PROFILE_ZONE("particles");
+    {
+        std::lock_guard<std::mutex> lock(spawnMutex);
+        for (auto &spawn: spawns) {
+            Spawn(spawn);
+        }
+        spawns.clear();
+    }
+    Kinematics::Integrate(velocityX.data(), velocityY.data(), accelerationX.data(), accelerationY.data(), count, deltaTime);
+    Kinematics::Integrate(positionX.data(), positionY.data(), velocityX.data(), velocityY.data(), count, deltaTime);
+    for (unsigned int i = 0; i < count; i++) {
+        age[i] += deltaTime;
+    }
+    for (unsigned int i = 0; i < count;) {
+        if (age[i] >= lifetime[i]) {
+            Kill(i);
+        } else {
+            i++;
+        }
+    }
+    static const unsigned int particles = Metrics::Register("particles", METRIC_GAUGE);
+    Metrics::Set(particles, count);
+}
+
+// all particles go out as one world-space quad list over the shared texture, size and colour are blended
+// from the emitter's start to end values over each particle's life and written straight into the draw list
+void ParticleSystem::Render() {
+    if (!texture || count == 0) {
+        return;
+    }
+    float maxHalf = 0.0f;
+    for (auto &emitter: definitions) {
+        maxHalf = std::max(maxHalf, std::max(emitter.startSize, emitter.endSize) * 0.5f);
+    }
+    float minX = positionX[0];
+    float minY = positionY[0];
+    float maxX = positionX[0];
+    float maxY = positionY[0];
+    for (unsigned int i = 0; i < count; i++) {
+        minX = std::min(minX, positionX[i]);
+        minY = std::min(minY, positionY[i]);
+        maxX = std::max(maxX, positionX[i]);
+        maxY = std::max(maxY, positionY[i]);
+    }
+    SDL_FRect bounds = {minX - maxHalf, minY - maxHalf, maxX - minX + maxHalf * 2.0f, maxY - minY + maxHalf * 2.0f};
+    Game::drawList->SetLayer(constants::PARTICLE_LAYER);
+    SDL_Vertex* vertices = Game::drawList->AddWorldQuads(texture, count, bounds);
+    for (unsigned int i = 0; i < count; i++) {
+        const ParticleEmitterDefinition& emitter = definitions[definition[i]];
+        float t = age[i] / lifetime[i];
+        float half = (emitter.startSize + (emitter.endSize - emitter.startSize) * t) * 0.5f;
+        SDL_Color color = {
+            static_cast<Uint8>(emitter.startColor.r + (emitter.endColor.r - emitter.startColor.r) * t),
+            static_cast<Uint8>(emitter.startColor.g + (emitter.endColor.g - emitter.startColor.g) * t),
+            static_cast<Uint8>(emitter.startColor.b + (emitter.endColor.b - emitter.startColor.b) * t),
+            static_cast<Uint8>(emitter.startColor.a + (emitter.endColor.a - emitter.startColor.a) * t)
+        };
+        float left = positionX[i] - half;
+        float top = positionY[i] - half;
+        float right = positionX[i] + half;
+        float bottom = positionY[i] + half;
+        SDL_Vertex* vertex = &vertices[i * 4];
+        vertex[0] = {{left, top}, color, {0.0f, 0.0f}};
+        vertex[1] = {{right, top}, color, {1.0f, 0.0f}};
+        vertex[2] = {{right, bottom}, color, {1.0f, 1.0f}};
+        vertex[3] = {{left, bottom}, color, {0.0f, 1.0f}};
+    }
+}
+
+unsigned int ParticleSystem::GetCount() const {
+    return count;
+}
@@ -0,0 +1,68 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <mutex>
+#include <random>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "./Constants.h"
+#include "../lib/glm/glm.hpp"
+
+struct ParticleEmitterDefinition {
+    float rate;
+    unsigned int burst;
+    float lifetime;
+    float lifetimeVariance;
+    float speed;
+    float speedVariance;
+    float direction;
+    float spread;
+    glm::vec2 gravity;
+    float startSize;
+    float endSize;
+    SDL_Color startColor;
+    SDL_Color endColor;
+};
+
+struct ParticleSpawn {
+    unsigned int definition;
+    glm::vec2 position;
+    unsigned int count;
+};
+
+// particles never become entities, every live particle is a slot in flat arrays that are integrated with
+// the same vector kernels as transforms and drawn as one textured geometry batch
+class ParticleSystem {
+    private:
+        std::vector<ParticleEmitterDefinition> definitions;
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> accelerationX;
+        std::vector<float> accelerationY;
+        std::vector<float> age;
+        std::vector<float> lifetime;
+        std::vector<unsigned short> definition;
+        unsigned int count;
+        std::mutex spawnMutex;
+        std::vector<ParticleSpawn> spawns;
+        std::minstd_rand random;
+        SDL_Texture* texture;
+        void Spawn(const ParticleSpawn& spawn);
+        void Kill(unsigned int index);
+        float RandomRange(float center, float variance);
+    public:
+        ParticleSystem();
+        ~ParticleSystem();
+        void Initialize();
+        void Clear();
+        unsigned int AddDefinition(const ParticleEmitterDefinition& definition);
+        const ParticleEmitterDefinition& GetDefinition(unsigned int definition) const;
+        void Emit(unsigned int definition, const glm::vec2& position, unsigned int count);
+        void Update(float deltaTime);
+        void Render();
+        unsigned int GetCount() const;
+};
+
+#endif
@@ -0,0 +1,289 @@
+#ifdef ENABLE_PROFILER
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include "./Profiler.h"
+#include "./Game.h"
+#include "./FontManager.h"
+#include "./GlyphAtlas.h"
+
+ProfileZoneRecord Profiler::records[constants::PROFILER_ZONE_CAPACITY];
+std::atomic<unsigned int> Profiler::writeIndex(0);
+unsigned int Profiler::frameBeginIndex = 0;
+unsigned int Profiler::lastFrameBeginIndex = 0;
+unsigned int Profiler::lastFrameEndIndex = 0;
+Uint64 Profiler::frameStart = 0;
+float Profiler::frameTimes[constants::PROFILER_FRAME_HISTORY];
+unsigned int Profiler::frameCount = 0;
+ProfileCounter Profiler::counters[constants::PROFILER_MAX_COUNTERS];
+unsigned int Profiler::counterCount = 0;
+std::mutex Profiler::counterMutex;
+std::ofstream Profiler::traceFile;
+Uint64 Profiler::captureStart = 0;
+bool Profiler::hasTraceEvents = false;
+
+static std::atomic<unsigned int> nextThreadIndex(0);
+static thread_local int threadIndex = -1;
+static thread_local unsigned int zoneDepth = 0;
+
+Uint64 Profiler::Now() {
+    return SDL_GetPerformanceCounter();
+}
+
+double Profiler::ToMilliseconds(Uint64 ticks) {
+    return static_cast<double>(ticks) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+unsigned int Profiler::GetThreadIndex() {
+    if (threadIndex < 0) {
+        threadIndex = nextThreadIndex++;
+    }
+    return threadIndex;
+}
+
+unsigned int Profiler::EnterZone() {
+    return zoneDepth++;
+}
+
+void Profiler::LeaveZone(const char* name, unsigned int depth, Uint64 start) {
+    zoneDepth--;
+    // the ring is shared by all threads, a slot is claimed with a single atomic increment
+    unsigned int index = writeIndex++;
+    ProfileZoneRecord& record = records[index % constants::PROFILER_ZONE_CAPACITY];
+    record.name = name;
+    record.threadIndex = GetThreadIndex();
+    record.depth = depth;
+    record.start = start;
+    record.end = Now();
+}
+
+void Profiler::EndFrame() {
+    Uint64 now = Now();
+    if (frameStart != 0) {
+        frameTimes[frameCount % constants::PROFILER_FRAME_HISTORY] = ToMilliseconds(now - frameStart);
+        frameCount++;
+    }
+    frameStart = now;
+    lastFrameBeginIndex = frameBeginIndex;
+    lastFrameEndIndex = writeIndex;
+    frameBeginIndex = lastFrameEndIndex;
+    if (traceFile.is_open()) {
+        WriteTraceEvents(now);
+    }
+    // counters describe a single frame, the next frame starts counting from zero
+    std::lock_guard<std::mutex> lock(counterMutex);
+    for (unsigned int i = 0; i < counterCount; i++) {
+        counters[i].value = 0.0;
+    }
+}
+
+void Profiler::WriteTraceEvents(Uint64 now) {
+    // timestamps and durations are microseconds since the capture started (chrome trace event format)
+    unsigned int begin = lastFrameBeginIndex;
+    if (lastFrameEndIndex - begin > constants::PROFILER_ZONE_CAPACITY) {
+        begin = lastFrameEndIndex - constants::PROFILER_ZONE_CAPACITY;
+    }
+    char line[256];
+    for (unsigned int i = begin; i != lastFrameEndIndex; i++) {
+        const ProfileZoneRecord& record = records[i % constants::PROFILER_ZONE_CAPACITY];
+        if (record.start < captureStart) {
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            hasTraceEvents ? "," : "", record.name, record.threadIndex,
+            ToMilliseconds(record.start - captureStart) * 1000.0, ToMilliseconds(record.end - record.start) * 1000.0);
+        traceFile << line;
+        hasTraceEvents = true;
+    }
+    std::lock_guard<std::mutex> lock(counterMutex);
+    for (unsigned int i = 0; i < counterCount; i++) {
+        std::snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"args\":{\"value\":%g}}",
+            hasTraceEvents ? "," : "", counters[i].name, ToMilliseconds(now - captureStart) * 1000.0, counters[i].value);
+        traceFile << line;
+        hasTraceEvents = true;
+    }
+}
+
+unsigned int Profiler::GetTopZones(ProfileZoneTotal* totals, unsigned int maxCount) {
+    static ProfileZoneTotal frameTotals[constants::PROFILER_MAX_ZONE_NAMES];
+    unsigned int nameCount = 0;
+    unsigned int begin = lastFrameBeginIndex;
+    if (lastFrameEndIndex - begin > constants::PROFILER_ZONE_CAPACITY) {
+        begin = lastFrameEndIndex - constants::PROFILER_ZONE_CAPACITY;
+    }
+    for (unsigned int i = begin; i != lastFrameEndIndex; i++) {
+        const ProfileZoneRecord& record = records[i % constants::PROFILER_ZONE_CAPACITY];
+        unsigned int nameIndex = 0;
+        while (nameIndex < nameCount && frameTotals[nameIndex].name != record.name) {
+            nameIndex++;
+        }
+        if (nameIndex == nameCount) {
+            if (nameCount == constants::PROFILER_MAX_ZONE_NAMES) {
+                continue;
+            }
+            frameTotals[nameCount++] = {record.name, 0.0, 0};
+        }
+        frameTotals[nameIndex].totalMs += ToMilliseconds(record.end - record.start);
+        frameTotals[nameIndex].calls++;
+    }
+    std::sort(frameTotals, frameTotals + nameCount, [](const ProfileZoneTotal& a, const ProfileZoneTotal& b) {
+        return a.totalMs > b.totalMs;
+    });
+    unsigned int count = std::min(nameCount, maxCount);
+    std::copy(frameTotals, frameTotals + count, totals);
+    return count;
+}
+
+float Profiler::GetFrameTime(unsigned int framesAgo) {
+    if (framesAgo >= frameCount || framesAgo >= constants::PROFILER_FRAME_HISTORY) {
+        return 0.0f;
+    }
+    return frameTimes[(frameCount - 1 - framesAgo) % constants::PROFILER_FRAME_HISTORY];
+}
+
+ProfileCounter* Profiler::FindCounter(const char* name) {
+    for (unsigned int i = 0; i < counterCount; i++) {
+        if (counters[i].name == name) {
+            return &counters[i];
+        }
+    }
+    if (counterCount == constants::PROFILER_MAX_COUNTERS) {
+        return NULL;
+    }
+    counters[counterCount] = {name, 0.0};
+    return &counters[counterCount++];
+}
+
+void Profiler::SetCounter(const char* name, double value) {
+    std::lock_guard<std::mutex> lock(counterMutex);
+    ProfileCounter* counter = FindCounter(name);
+    if (counter) {
+        counter->value = value;
+    }
+}
+
+void Profiler::AddCounter(const char* name, double delta) {
+    std::lock_guard<std::mutex> lock(counterMutex);
+    ProfileCounter* counter = FindCounter(name);
+    if (counter) {
+        counter->value += delta;
+    }
+}
+
+bool Profiler::StartCapture(const std::string& filePath) {
+    if (traceFile.is_open()) {
+        StopCapture();
+    }
+    traceFile.open(filePath.c_str(), std::ios::out | std::ios::trunc);
+    if (!traceFile.is_open()) {
+        std::cerr << "Error opening trace file " << filePath << std::endl;
+        return false;
+    }
+    traceFile << "{\"traceEvents\":[";
+    captureStart = Now();
+    hasTraceEvents = false;
+    std::cout << "Trace capture started: " << filePath << std::endl;
+    return true;
+}
+
+void Profiler::StopCapture() {
+    if (!traceFile.is_open()) {
+        return;
+    }
+    traceFile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    traceFile.close();
+    std::cout << "Trace capture stopped" << std::endl;
+}
+
+bool Profiler::IsCapturing() {
+    return traceFile.is_open();
+}
+
+ProfilerOverlay::ProfilerOverlay() {
+    isVisible = false;
+    font = FontManager::LoadFont(constants::PROFILER_FONT_FILE, constants::PROFILER_FONT_SIZE);
+    glyphAtlas = font ? new GlyphAtlas(font, false) : NULL;
+    lineCount = 0;
+    framesUntilRefresh = 0;
+}
+
+ProfilerOverlay::~ProfilerOverlay() {
+    delete glyphAtlas;
+    if (font) {
+        TTF_CloseFont(font);
+    }
+}
+
+void ProfilerOverlay::Toggle() {
+    isVisible = !isVisible;
+    framesUntilRefresh = 0;
+}
+
+// lines are laid out through the same glyph atlas path as text labels and merged into one geometry call
+void ProfilerOverlay::SetLine(unsigned int lineIndex, const char* text) {
+    int y = constants::PROFILER_PANEL_Y + 68 + lineIndex * (constants::PROFILER_FONT_SIZE + 4);
+    glyphAtlas->Layout(text, constants::PROFILER_PANEL_X + 4, y, 1.0f, constants::GREEN_COLOR, lineVertices, lineIndices);
+    int first = static_cast<int>(vertices.size());
+    vertices.insert(vertices.end(), lineVertices.begin(), lineVertices.end());
+    for (auto& index: lineIndices) {
+        indices.push_back(first + index);
+    }
+}
+
+void ProfilerOverlay::RefreshText() {
+    vertices.clear();
+    indices.clear();
+    char text[64];
+    float frameTime = Profiler::GetFrameTime(0);
+    std::snprintf(text, sizeof(text), "frame %.2f ms (%.0f fps)", frameTime, frameTime > 0.0f ? 1000.0f / frameTime : 0.0f);
+    SetLine(0, text);
+
+    ProfileZoneTotal totals[constants::PROFILER_OVERLAY_LINES - 1];
+    unsigned int zoneCount = Profiler::GetTopZones(totals, constants::PROFILER_OVERLAY_LINES - 1);
+    for (unsigned int i = 0; i < zoneCount; i++) {
+        std::snprintf(text, sizeof(text), "%-12s %6.2f ms x%u", totals[i].name, totals[i].totalMs, totals[i].calls);
+        SetLine(i + 1, text);
+    }
+    lineCount = zoneCount + 1;
+}
+
+void ProfilerOverlay::RenderGraph(const SDL_Rect& area) {
+    SDL_Point points[constants::PROFILER_FRAME_HISTORY];
+    float scale = area.h / (2.0f * 1000.0f / constants::FPS);
+    for (unsigned int i = 0; i < constants::PROFILER_FRAME_HISTORY; i++) {
+        float height = std::min(Profiler::GetFrameTime(constants::PROFILER_FRAME_HISTORY - 1 - i) * scale, static_cast<float>(area.h));
+        points[i].x = area.x + i * area.w / constants::PROFILER_FRAME_HISTORY;
+        points[i].y = area.y + area.h - static_cast<int>(height);
+    }
+    SDL_SetRenderDrawColor(Game::renderer, 255, 255, 0, 255);
+    int targetY = area.y + area.h / 2;
+    SDL_RenderDrawLine(Game::renderer, area.x, targetY, area.x + area.w, targetY);
+    SDL_SetRenderDrawColor(Game::renderer, 0, 255, 0, 255);
+    SDL_RenderDrawLines(Game::renderer, points, constants::PROFILER_FRAME_HISTORY);
+}
+
+void ProfilerOverlay::Render() {
+    if (!isVisible || !glyphAtlas) {
+        return;
+    }
+    if (framesUntilRefresh == 0) {
+        RefreshText();
+        framesUntilRefresh = constants::PROFILER_OVERLAY_REFRESH_FRAMES;
+    }
+    framesUntilRefresh--;
+
+    SDL_Rect panel = {constants::PROFILER_PANEL_X, constants::PROFILER_PANEL_Y, 260, 70 + static_cast<int>(lineCount) * (constants::PROFILER_FONT_SIZE + 4)};
+    SDL_SetRenderDrawBlendMode(Game::renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(Game::renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(Game::renderer, &panel);
+
+    // the graph spans two frame targets, the yellow line marks one frame at FPS
+    RenderGraph({panel.x + 4, panel.y + 4, panel.w - 8, 60});
+
+    if (!indices.empty()) {
+        SDL_RenderGeometry(Game::renderer, glyphAtlas->GetTexture(), vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+    }
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// zones, counters, trace capture and the overlay only exist in builds compiled with ENABLE_PROFILER (make profile),
+// release builds expand every PROFILE_ macro to nothing
+#ifdef ENABLE_PROFILER
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "./Constants.h"
+
+struct ProfileZoneRecord {
+    const char* name;
+    unsigned int threadIndex;
+    unsigned int depth;
+    Uint64 start;
+    Uint64 end;
+};
+
+struct ProfileZoneTotal {
+    const char* name;
+    double totalMs;
+    unsigned int calls;
+};
+
+struct ProfileCounter {
+    const char* name;
+    double value;
+};
+
+class Profiler {
+    private:
+        static ProfileZoneRecord records[constants::PROFILER_ZONE_CAPACITY];
+        static std::atomic<unsigned int> writeIndex;
+        static unsigned int frameBeginIndex;
+        static unsigned int lastFrameBeginIndex;
+        static unsigned int lastFrameEndIndex;
+        static Uint64 frameStart;
+        static float frameTimes[constants::PROFILER_FRAME_HISTORY];
+        static unsigned int frameCount;
+        static ProfileCounter counters[constants::PROFILER_MAX_COUNTERS];
+        static unsigned int counterCount;
+        static std::mutex counterMutex;
+        static std::ofstream traceFile;
+        static Uint64 captureStart;
+        static bool hasTraceEvents;
+        static ProfileCounter* FindCounter(const char* name);
+        static void WriteTraceEvents(Uint64 now);
+    public:
+        static Uint64 Now();
+        static double ToMilliseconds(Uint64 ticks);
+        static unsigned int GetThreadIndex();
+        static unsigned int EnterZone();
+        static void LeaveZone(const char* name, unsigned int depth, Uint64 start);
+        static void EndFrame();
+        static unsigned int GetTopZones(ProfileZoneTotal* totals, unsigned int maxCount);
+        static float GetFrameTime(unsigned int framesAgo);
+        static void SetCounter(const char* name, double value);
+        static void AddCounter(const char* name, double delta);
+        static bool StartCapture(const std::string& filePath);
+        static void StopCapture();
+        static bool IsCapturing();
+};
+
+class ProfileZone {
+    private:
+        const char* name;
+        unsigned int depth;
+        Uint64 start;
+    public:
+        ProfileZone(const char* name): name(name) {
+            depth = Profiler::EnterZone();
+            start = Profiler::Now();
+        }
+        ~ProfileZone() {
+            Profiler::LeaveZone(name, depth, start);
+        }
+};
+
+class GlyphAtlas;
+
+class ProfilerOverlay {
+    private:
+        bool isVisible;
+        TTF_Font* font;
+        GlyphAtlas* glyphAtlas;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        std::vector<SDL_Vertex> lineVertices;
+        std::vector<int> lineIndices;
+        unsigned int lineCount;
+        unsigned int framesUntilRefresh;
+        void SetLine(unsigned int lineIndex, const char* text);
+        void RefreshText();
+        void RenderGraph(const SDL_Rect& area);
+    public:
+        ProfilerOverlay();
+        ~ProfilerOverlay();
+        void Toggle();
+        void Render();
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_END_FRAME() Profiler::EndFrame()
+#define PROFILE_COUNTER(name, value) Profiler::SetCounter(name, value)
+#define PROFILE_COUNTER_ADD(name, delta) Profiler::AddCounter(name, delta)
+
+#else
+
+#define PROFILE_ZONE(name)
+#define PROFILE_END_FRAME()
+#define PROFILE_COUNTER(name, value)
+#define PROFILE_COUNTER_ADD(name, delta)
+
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+#include <cstring>
+#include <iostream>
+#include "./Replay.h"
+
+static const char REPLAY_MAGIC[4] = {'R', 'P', 'L', 'Y'};
+static const Uint32 REPLAY_VERSION = 1;
+
+static bool IsSameSnapshot(const ActionSnapshot& a, const ActionSnapshot& b) {
+    return a.state == b.state && a.pressed == b.pressed && a.released == b.released;
+}
+
+bool ReplayRecorder::Open(std::string filePath, Uint32 seed, Uint32 tickRate, Uint32 levelNumber) {
+    file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error opening replay file " << filePath << " for recording." << std::endl;
+        return false;
+    }
+    ReplayHeader header;
+    std::memcpy(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    header.version = REPLAY_VERSION;
+    header.seed = seed;
+    header.tickRate = tickRate;
+    header.levelNumber = levelNumber;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    currentRun.tickCount = 0;
+    return true;
+}
+
+bool ReplayRecorder::IsOpen() const {
+    return file.is_open();
+}
+
+void ReplayRecorder::Record(const ActionSnapshot& snapshot) {
+    if (currentRun.tickCount > 0 && IsSameSnapshot(currentRun.snapshot, snapshot)) {
+        currentRun.tickCount++;
+        return;
+    }
+    FlushRun();
+    currentRun.tickCount = 1;
+    currentRun.snapshot = snapshot;
+}
+
+void ReplayRecorder::FlushRun() {
+    if (currentRun.tickCount > 0) {
+        file.write(reinterpret_cast<const char*>(&currentRun), sizeof(currentRun));
+    }
+}
+
+void ReplayRecorder::Close() {
+    if (file.is_open()) {
+        FlushRun();
+        currentRun.tickCount = 0;
+        file.close();
+    }
+}
+
+bool ReplayPlayer::Open(std::string filePath) {
+    file.open(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error opening replay file " << filePath << "." << std::endl;
+        return false;
+    }
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 || header.version != REPLAY_VERSION || header.tickRate == 0) {
+        std::cerr << "Error reading replay file " << filePath << "." << std::endl;
+        file.close();
+        return false;
+    }
+    currentRun.tickCount = 0;
+    return true;
+}
+
+bool ReplayPlayer::IsOpen() const {
+    return file.is_open();
+}
+
+const ReplayHeader& ReplayPlayer::GetHeader() const {
+    return header;
+}
+
+bool ReplayPlayer::NextTick(ActionSnapshot& snapshot) {
+    if (currentRun.tickCount == 0) {
+        file.read(reinterpret_cast<char*>(&currentRun), sizeof(currentRun));
+        if (!file || currentRun.tickCount == 0) {
+            return false;
+        }
+    }
+    currentRun.tickCount--;
+    snapshot = currentRun.snapshot;
+    return true;
+}
+
+void ReplayPlayer::Close() {
+    file.close();
+}
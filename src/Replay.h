@@ -0,0 +1,48 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <fstream>
+#include <string>
+#include <SDL2/SDL.h>
+#include "./InputManager.h"
+
+struct ReplayHeader {
+    char magic[4];
+    Uint32 version;
+    Uint32 seed;
+    Uint32 tickRate;
+    Uint32 levelNumber;
+};
+
+// ticks with identical action snapshots are stored as a single run
+struct ReplayRun {
+    Uint32 tickCount;
+    ActionSnapshot snapshot;
+};
+
+class ReplayRecorder {
+    private:
+        std::ofstream file;
+        ReplayRun currentRun;
+        void FlushRun();
+    public:
+        bool Open(std::string filePath, Uint32 seed, Uint32 tickRate, Uint32 levelNumber);
+        bool IsOpen() const;
+        void Record(const ActionSnapshot& snapshot);
+        void Close();
+};
+
+class ReplayPlayer {
+    private:
+        std::ifstream file;
+        ReplayHeader header;
+        ReplayRun currentRun;
+    public:
+        bool Open(std::string filePath);
+        bool IsOpen() const;
+        const ReplayHeader& GetHeader() const;
+        bool NextTick(ActionSnapshot& snapshot);
+        void Close();
+};
+
+#endif
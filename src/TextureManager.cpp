@@ -1,13 +1,34 @@
 #include "./TextureManager.h"
+#include "./Metrics.h"
 
 SDL_Texture* TextureManager::LoadTexture(const char* fileName) {
+    // headless runs have no renderer, so texture uploads are skipped entirely
+    if (!Game::renderer) {
+        return NULL;
+    }
     SDL_Surface* surface = IMG_Load(fileName);
     SDL_Texture* texture = SDL_CreateTextureFromSurface(Game::renderer, surface); 
     SDL_FreeSurface(surface);
     return texture; 
 } 
 
-void TextureManager::Draw(SDL_Texture* texture, SDL_Rect sourceRectangle, SDL_Rect destinationRectangle, SDL_RendererFlip flip) {
-    SDL_RenderCopyEx(Game::renderer, texture, &sourceRectangle, &destinationRectangle, 0.0, NULL, flip);
+// draws are only recorded here, each camera culls and maps them to its viewport when the list is flushed
+void TextureManager::Draw(SDL_Texture* texture, SDL_Rect sourceRectangle, SDL_FRect worldRectangle, SDL_RendererFlip flip, float angle, SDL_FPoint pivot) {
+    Game::drawList->Add(texture, sourceRectangle, worldRectangle, flip, angle, pivot);
+}
+
+void TextureManager::DrawScreen(SDL_Texture* texture, SDL_Rect sourceRectangle, SDL_Rect destinationRectangle, SDL_RendererFlip flip) {
+    Game::drawList->AddScreen(texture, sourceRectangle, destinationRectangle, flip);
+}
+
+void TextureManager::CountDrawCall(SDL_Texture* texture) {
+    static const unsigned int drawCalls = Metrics::Register("draw calls", METRIC_COUNTER);
+    static const unsigned int textureSwitches = Metrics::Register("texture switches", METRIC_COUNTER);
+    static SDL_Texture* lastTexture = NULL;
+    Metrics::Add(drawCalls, 1);
+    if (texture != lastTexture) {
+        Metrics::Add(textureSwitches, 1);
+        lastTexture = texture;
+    }
 }
 
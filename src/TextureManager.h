@@ -6,7 +6,9 @@
 class TextureManager {
     public:
         static SDL_Texture* LoadTexture(const char* fileName);
-        static void Draw(SDL_Texture* texture, SDL_Rect sourceRectangle, SDL_Rect destinationRectangle, SDL_RendererFlip flip);
+        static void Draw(SDL_Texture* texture, SDL_Rect sourceRectangle, SDL_FRect worldRectangle, SDL_RendererFlip flip, float angle = 0.0f, SDL_FPoint pivot = {0.5f, 0.5f});
+        static void DrawScreen(SDL_Texture* texture, SDL_Rect sourceRectangle, SDL_Rect destinationRectangle, SDL_RendererFlip flip);
+        static void CountDrawCall(SDL_Texture* texture);
 };
 
 #endif
\ No newline at end of file